@@ -0,0 +1,266 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#include "BitKernels.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FORESTER_AVX2_KERNELS
+#include <immintrin.h>
+#endif
+
+using Word = BitKernels::Word;
+
+/*
+ * Scalar kernels
+ */
+
+static int popcountScalar(const Word* row, int words) noexcept
+{
+    int count = 0;
+
+    for (int i = 0; i < words; i++)
+    {
+        count += BitMatrix::popcount(row[i]);
+    }
+
+    return count;
+}
+
+static int intersectionCountScalar(const Word* row1, const Word* row2, int words) noexcept
+{
+    int count = 0;
+
+    for (int i = 0; i < words; i++)
+    {
+        count += BitMatrix::popcount(row1[i] & row2[i]);
+    }
+
+    return count;
+}
+
+static void intersectScalar(Word* result, const Word* row1, const Word* row2, int words) noexcept
+{
+    for (int i = 0; i < words; i++)
+    {
+        result[i] = row1[i] & row2[i];
+    }
+}
+
+static void subtractScalar(Word* result, const Word* row1, const Word* row2, int words) noexcept
+{
+    for (int i = 0; i < words; i++)
+    {
+        result[i] = row1[i] & ~row2[i];
+    }
+}
+
+static void uniteScalar(Word* result, const Word* row1, const Word* row2, int words) noexcept
+{
+    for (int i = 0; i < words; i++)
+    {
+        result[i] = row1[i] | row2[i];
+    }
+}
+
+#ifdef FORESTER_AVX2_KERNELS
+
+/*
+ * AVX2 kernels, popcount uses nibble lookup table (Muła, Kurz, Lemire)
+ */
+
+__attribute__((target("avx2,popcnt")))
+static inline __m256i popcountBytes(__m256i vector) noexcept
+{
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowMask = _mm256_set1_epi8(0x0f);
+
+    const __m256i low = _mm256_and_si256(vector, lowMask);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(vector, 4), lowMask);
+
+    return _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+}
+
+__attribute__((target("avx2,popcnt")))
+static inline int sumLanes(__m256i vector) noexcept
+{
+    alignas(32) Word lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), vector);
+
+    return static_cast<int>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+
+__attribute__((target("avx2,popcnt")))
+static int popcountAvx2(const Word* row, int words) noexcept
+{
+    __m256i total = _mm256_setzero_si256();
+    int i = 0;
+
+    for (; i + 4 <= words; i += 4)
+    {
+        const __m256i vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(popcountBytes(vector), _mm256_setzero_si256()));
+    }
+
+    int count = sumLanes(total);
+
+    for (; i < words; i++)
+    {
+        count += __builtin_popcountll(row[i]);
+    }
+
+    return count;
+}
+
+__attribute__((target("avx2,popcnt")))
+static int intersectionCountAvx2(const Word* row1, const Word* row2, int words) noexcept
+{
+    __m256i total = _mm256_setzero_si256();
+    int i = 0;
+
+    for (; i + 4 <= words; i += 4)
+    {
+        const __m256i vector = _mm256_and_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row2 + i)));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(popcountBytes(vector), _mm256_setzero_si256()));
+    }
+
+    int count = sumLanes(total);
+
+    for (; i < words; i++)
+    {
+        count += __builtin_popcountll(row1[i] & row2[i]);
+    }
+
+    return count;
+}
+
+__attribute__((target("avx2")))
+static void intersectAvx2(Word* result, const Word* row1, const Word* row2, int words) noexcept
+{
+    int i = 0;
+
+    for (; i + 4 <= words; i += 4)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_and_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row2 + i))));
+    }
+
+    intersectScalar(result + i, row1 + i, row2 + i, words - i);
+}
+
+__attribute__((target("avx2")))
+static void subtractAvx2(Word* result, const Word* row1, const Word* row2, int words) noexcept
+{
+    int i = 0;
+
+    for (; i + 4 <= words; i += 4)
+    {
+        // andnot negates its first operand
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_andnot_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row2 + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + i))));
+    }
+
+    subtractScalar(result + i, row1 + i, row2 + i, words - i);
+}
+
+__attribute__((target("avx2")))
+static void uniteAvx2(Word* result, const Word* row1, const Word* row2, int words) noexcept
+{
+    int i = 0;
+
+    for (; i + 4 <= words; i += 4)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_or_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row2 + i))));
+    }
+
+    uniteScalar(result + i, row1 + i, row2 + i, words - i);
+}
+
+#endif
+
+/*
+ * Runtime dispatch
+ */
+
+struct KernelTable
+{
+    bool avx2;
+    int (*popcount)(const Word*, int) noexcept;
+    int (*intersectionCount)(const Word*, const Word*, int) noexcept;
+    void (*intersect)(Word*, const Word*, const Word*, int) noexcept;
+    void (*subtract)(Word*, const Word*, const Word*, int) noexcept;
+    void (*unite)(Word*, const Word*, const Word*, int) noexcept;
+};
+
+static KernelTable selectKernels() noexcept
+{
+#ifdef FORESTER_AVX2_KERNELS
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+    {
+        return {true, popcountAvx2, intersectionCountAvx2, intersectAvx2, subtractAvx2, uniteAvx2};
+    }
+#endif
+
+    return {false, popcountScalar, intersectionCountScalar, intersectScalar, subtractScalar, uniteScalar};
+}
+
+static const KernelTable& kernels() noexcept
+{
+    static const KernelTable table = selectKernels();
+
+    return table;
+}
+
+bool BitKernels::usesAvx2() noexcept
+{
+    return kernels().avx2;
+}
+
+int BitKernels::popcount(const Word* row, int words) noexcept
+{
+    return kernels().popcount(row, words);
+}
+
+int BitKernels::intersectionCount(const Word* row1, const Word* row2, int words) noexcept
+{
+    return kernels().intersectionCount(row1, row2, words);
+}
+
+void BitKernels::intersect(Word* result, const Word* row1, const Word* row2, int words) noexcept
+{
+    kernels().intersect(result, row1, row2, words);
+}
+
+void BitKernels::subtract(Word* result, const Word* row1, const Word* row2, int words) noexcept
+{
+    kernels().subtract(result, row1, row2, words);
+}
+
+void BitKernels::unite(Word* result, const Word* row1, const Word* row2, int words) noexcept
+{
+    kernels().unite(result, row1, row2, words);
+}
@@ -0,0 +1,85 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#pragma once
+
+#include "BitMatrix.hpp"
+
+/**
+ * Word parallel kernels over bit rows
+ * AVX2 implementation is selected at runtime when supported by CPU, scalar one otherwise
+ */
+class BitKernels
+{
+
+public:
+
+    using Word = BitMatrix::Word;
+
+public:
+
+    /**
+     * Returns whether AVX2 implementation is in use
+     * @return
+     */
+    static bool usesAvx2() noexcept;
+
+    /**
+     * Returns number of set bits in row
+     * @param row
+     * @param words
+     * @return
+     */
+    static int popcount(const Word* row, int words) noexcept;
+
+    /**
+     * Returns number of bits set in both rows
+     * @param row1
+     * @param row2
+     * @param words
+     * @return
+     */
+    static int intersectionCount(const Word* row1, const Word* row2, int words) noexcept;
+
+    /**
+     * Stores bitwise AND of rows into result, result may alias any input
+     * @param result
+     * @param row1
+     * @param row2
+     * @param words
+     */
+    static void intersect(Word* result, const Word* row1, const Word* row2, int words) noexcept;
+
+    /**
+     * Stores bits of first row not set in second row into result, result may alias any input
+     * @param result
+     * @param row1
+     * @param row2
+     * @param words
+     */
+    static void subtract(Word* result, const Word* row1, const Word* row2, int words) noexcept;
+
+    /**
+     * Stores bitwise OR of rows into result, result may alias any input
+     * @param result
+     * @param row1
+     * @param row2
+     * @param words
+     */
+    static void unite(Word* result, const Word* row1, const Word* row2, int words) noexcept;
+};
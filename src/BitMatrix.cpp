@@ -0,0 +1,157 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#include <algorithm>
+#include "BitMatrix.hpp"
+#include "BitKernels.hpp"
+
+BitMatrix::BitMatrix(const std::vector<std::vector<bool>>& matrix) :
+    BitMatrix(static_cast<int>(matrix.size()))
+{
+    for (int i = 0; i < m_size; i++)
+    {
+        for (int j = 0; j < m_size; j++)
+        {
+            if (matrix[i][j])
+            {
+                set(i, j);
+            }
+        }
+    }
+}
+
+int BitMatrix::rowCount(int index) const noexcept
+{
+    return BitKernels::popcount(row(index), m_words);
+}
+
+void BitMatrix::addNode()
+{
+    if (wordCount(m_size + 1) != m_words)
+    {
+        relayout(wordCount(m_size + 1));
+    }
+
+    m_data.resize(m_data.size() + m_words, 0);
+    m_size++;
+}
+
+void BitMatrix::removeNode(int index)
+{
+    const int word = index / WORD_BITS;
+    const Word lowMask = (Word(1) << (index % WORD_BITS)) - 1;
+
+    for (int i = 0; i < m_size; i++)
+    {
+        Word* data = row(i);
+
+        // shift all bits above index one position down
+        data[word] = (data[word] & lowMask) | ((data[word] >> 1) & ~lowMask);
+
+        for (int j = word + 1; j < m_words; j++)
+        {
+            data[j - 1] |= data[j] << (WORD_BITS - 1);
+            data[j] >>= 1;
+        }
+    }
+
+    m_data.erase(m_data.begin() + static_cast<std::size_t>(index) * m_words,
+                 m_data.begin() + static_cast<std::size_t>(index + 1) * m_words);
+    m_size--;
+
+    if (wordCount(m_size) != m_words)
+    {
+        relayout(wordCount(m_size));
+    }
+}
+
+void BitMatrix::removeNodes(const std::vector<int>& indices)
+{
+    std::vector<int> position(m_size, -1);
+    int size = 0;
+
+    for (int i = 0, next = 0; i < m_size; i++)
+    {
+        if (next < static_cast<int>(indices.size()) && indices[next] == i)
+        {
+            next++;
+            continue;
+        }
+
+        position[i] = size++;
+    }
+
+    BitMatrix matrix(size, resource());
+
+    for (int i = 0; i < m_size; i++)
+    {
+        if (position[i] == -1)
+        {
+            continue;
+        }
+
+        const Word* data = row(i);
+
+        for (int j = 0; j < m_words; j++)
+        {
+            Word word = data[j];
+
+            while (word)
+            {
+                const int column = position[j * WORD_BITS + countTrailingZeros(word)];
+                word &= word - 1;
+
+                if (column != -1)
+                {
+                    matrix.set(position[i], column);
+                }
+            }
+        }
+    }
+
+    *this = std::move(matrix);
+}
+
+std::vector<std::vector<bool>> BitMatrix::toVector() const
+{
+    std::vector<std::vector<bool>> matrix(m_size, std::vector<bool>(m_size, false));
+
+    for (int i = 0; i < m_size; i++)
+    {
+        for (int j = 0; j < m_size; j++)
+        {
+            matrix[i][j] = get(i, j);
+        }
+    }
+
+    return matrix;
+}
+
+void BitMatrix::relayout(int words)
+{
+    std::pmr::vector<Word> data(static_cast<std::size_t>(m_size) * words, 0, resource());
+    const int common = std::min(words, m_words);
+
+    for (int i = 0; i < m_size; i++)
+    {
+        std::copy(row(i), row(i) + common, data.begin() + static_cast<std::size_t>(i) * words);
+    }
+
+    m_data = std::move(data);
+    m_words = words;
+}
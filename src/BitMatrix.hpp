@@ -0,0 +1,249 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+class BitMatrix
+{
+
+public:
+
+    using Word = std::uint64_t;
+
+    static constexpr int WORD_BITS = 64;
+
+protected:
+
+    int m_size;
+    int m_words;
+    std::pmr::vector<Word> m_data;
+
+public:
+
+    /**
+     * Constructor of empty matrix
+     * @param resource
+     */
+    explicit BitMatrix(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept :
+        m_size(0),
+        m_words(0),
+        m_data(resource)
+    {}
+
+    /**
+     * Constructor of square matrix with all bits cleared
+     * @param size
+     * @param resource
+     */
+    explicit BitMatrix(int size, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+        m_size(size),
+        m_words(wordCount(size)),
+        m_data(static_cast<std::size_t>(size) * wordCount(size), 0, resource)
+    {}
+
+    /**
+     * Copy constructor placing copy into given memory resource
+     * @param other
+     * @param resource
+     */
+    BitMatrix(const BitMatrix& other, std::pmr::memory_resource* resource) :
+        m_size(other.m_size),
+        m_words(other.m_words),
+        m_data(other.m_data, resource)
+    {}
+
+    /**
+     * Move constructor placing result into given memory resource, storage is copied if resources differ
+     * @param other
+     * @param resource
+     */
+    BitMatrix(BitMatrix&& other, std::pmr::memory_resource* resource) :
+        m_size(other.m_size),
+        m_words(other.m_words),
+        m_data(std::move(other.m_data), resource)
+    {}
+
+    BitMatrix(const BitMatrix& other) = default;
+    BitMatrix(BitMatrix&& other) noexcept = default;
+    BitMatrix& operator=(const BitMatrix& other) = default;
+    BitMatrix& operator=(BitMatrix&& other) = default;
+
+    /**
+     * Constructor by bool matrix
+     * @param matrix
+     */
+    explicit BitMatrix(const std::vector<std::vector<bool>>& matrix);
+
+public:
+
+    /**
+     * Returns number of words needed to store given number of bits
+     * @param bits
+     * @return
+     */
+    static int wordCount(int bits) noexcept
+    {
+        return (bits + WORD_BITS - 1) / WORD_BITS;
+    }
+
+    /**
+     * Returns number of set bits in word
+     * @param word
+     * @return
+     */
+    static constexpr int popcount(Word word) noexcept
+    {
+        return __builtin_popcountll(word);
+    }
+
+    /**
+     * Returns index of lowest set bit in non-zero word
+     * @param word
+     * @return
+     */
+    static constexpr int countTrailingZeros(Word word) noexcept
+    {
+        return __builtin_ctzll(word);
+    }
+
+public:
+
+    /**
+     * Returns memory resource used for storage
+     * @return
+     */
+    std::pmr::memory_resource* resource() const noexcept
+    {
+        return m_data.get_allocator().resource();
+    }
+
+    /**
+     * Returns number of rows (and columns)
+     * @return
+     */
+    int size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * Returns number of words in each row
+     * @return
+     */
+    int words() const noexcept
+    {
+        return m_words;
+    }
+
+    /**
+     * Returns pointer to first word of given row
+     * @param index
+     * @return
+     */
+    const Word* row(int index) const noexcept
+    {
+        return m_data.data() + static_cast<std::size_t>(index) * m_words;
+    }
+
+    /**
+     * Returns pointer to first word of given row
+     * @param index
+     * @return
+     */
+    Word* row(int index) noexcept
+    {
+        return m_data.data() + static_cast<std::size_t>(index) * m_words;
+    }
+
+    /**
+     * Returns number of set bits in given row
+     * @param index
+     * @return
+     */
+    int rowCount(int index) const noexcept;
+
+public:
+
+    /**
+     * Returns bit at given position
+     * @param rowIndex
+     * @param colIndex
+     * @return
+     */
+    bool get(int rowIndex, int colIndex) const noexcept
+    {
+        return (row(rowIndex)[colIndex / WORD_BITS] >> (colIndex % WORD_BITS)) & 1U;
+    }
+
+    /**
+     * Sets bit at given position
+     * @param rowIndex
+     * @param colIndex
+     */
+    void set(int rowIndex, int colIndex) noexcept
+    {
+        row(rowIndex)[colIndex / WORD_BITS] |= Word(1) << (colIndex % WORD_BITS);
+    }
+
+    /**
+     * Clears bit at given position
+     * @param rowIndex
+     * @param colIndex
+     */
+    void reset(int rowIndex, int colIndex) noexcept
+    {
+        row(rowIndex)[colIndex / WORD_BITS] &= ~(Word(1) << (colIndex % WORD_BITS));
+    }
+
+public:
+
+    /**
+     * Appends empty row and column
+     */
+    void addNode();
+
+    /**
+     * Removes row and column at given index
+     * @param index
+     */
+    void removeNode(int index);
+
+    /**
+     * Removes rows and columns at given sorted indices at once
+     * @param indices
+     */
+    void removeNodes(const std::vector<int>& indices);
+
+    /**
+     * Returns bool matrix representation
+     * @return
+     */
+    std::vector<std::vector<bool>> toVector() const;
+
+protected:
+
+    /**
+     * Changes number of words in each row, keeping stored bits
+     * @param words
+     */
+    void relayout(int words);
+};
@@ -0,0 +1,351 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+
+#include <algorithm>
+#include <numeric>
+#include "CircumferenceSearch.hpp"
+#include "ThreadPool.hpp"
+
+CircumferenceSearch::CircumferenceSearch(const Graph& graph) :
+    m_degree(graph.getDegree()),
+    m_offsets(graph.getDegree() + 1, 0)
+{
+    for (int i = 0; i < m_degree; i++)
+    {
+        m_offsets[i + 1] = m_offsets[i] + graph.getNodeDegree(i);
+    }
+
+    m_targets.reserve(m_offsets[m_degree]);
+
+    for (int i = 0; i < m_degree; i++)
+    {
+        for (int neighbour : graph.getNodeNeighbourRange(i))
+        {
+            m_targets.push_back(neighbour);
+        }
+    }
+}
+
+int CircumferenceSearch::find(int bound, int limit) const
+{
+    limit = std::min({limit, m_degree, independentBound()});
+
+    ThreadPool& pool = ThreadPool::instance();
+    const int chunks = std::min(m_degree, 4 * pool.getThreadCount());
+    std::atomic<int> best(bound);
+
+    // low starts have most nodes above them and tend to find long circles first
+    pool.parallelFor(chunks, [&](int chunk)
+    {
+        Workspace workspace;
+        workspace.allowed.resize(m_degree);
+        workspace.visited.assign(m_degree, 0);
+        workspace.remaining.resize(m_degree);
+        workspace.marks.assign(m_degree, 0);
+
+        for (int i = chunk; i < m_degree && m_degree - i > best && best < limit; i += chunks)
+        {
+            searchFrom(i, best, limit, workspace);
+        }
+    });
+
+    return best;
+}
+
+int CircumferenceSearch::independentBound() const
+{
+    std::vector<int> order(m_degree);
+    std::vector<char> blocked(m_degree, 0);
+    int independent = 0;
+
+    // nodes of low degree block fewest others
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return m_offsets[a + 1] - m_offsets[a] < m_offsets[b + 1] - m_offsets[b];
+    });
+
+    for (int node : order)
+    {
+        if (blocked[node])
+        {
+            continue;
+        }
+
+        independent++;
+
+        for (int i = m_offsets[node]; i < m_offsets[node + 1]; i++)
+        {
+            blocked[m_targets[i]] = 1;
+        }
+    }
+
+    return 2 * (m_degree - independent);
+}
+
+void CircumferenceSearch::searchFrom(int start, std::atomic<int>& best, int limit, Workspace& workspace) const
+{
+    if (restrict(start, workspace) <= best || !workspace.allowed[start])
+    {
+        return;
+    }
+
+    // candidates of all open path positions are kept in single stack
+    struct Frame
+    {
+        int base;
+        int next;
+    };
+
+    std::vector<Frame> frames;
+    std::vector<int> stack;
+
+    workspace.path.assign(1, start);
+    workspace.visited[start] = 1;
+
+    for (int i = m_offsets[start]; i < m_offsets[start + 1]; i++)
+    {
+        if (workspace.allowed[m_targets[i]])
+        {
+            stack.push_back(m_targets[i]);
+        }
+    }
+
+    frames.push_back({0, 0});
+
+    while (!frames.empty() && best < limit)
+    {
+        Frame& frame = frames.back();
+
+        if (frame.next == static_cast<int>(stack.size()))
+        {
+            stack.resize(frame.base);
+            frames.pop_back();
+            workspace.visited[workspace.path.back()] = 0;
+            workspace.path.pop_back();
+            continue;
+        }
+
+        const int node = stack[frame.next++];
+
+        if (workspace.visited[node])
+        {
+            continue;
+        }
+
+        workspace.visited[node] = 1;
+        workspace.path.push_back(node);
+
+        const int length = static_cast<int>(workspace.path.size());
+
+        if (length >= 3 && std::binary_search(m_targets.begin() + m_offsets[node],
+                                              m_targets.begin() + m_offsets[node + 1], start))
+        {
+            int current = best;
+
+            while (length > current && !best.compare_exchange_weak(current, length))
+            {
+            }
+        }
+
+        if (length + reachable(start, workspace) <= best)
+        {
+            workspace.visited[node] = 0;
+            workspace.path.pop_back();
+            continue;
+        }
+
+        const int base = static_cast<int>(stack.size());
+
+        for (int i = m_offsets[node]; i < m_offsets[node + 1]; i++)
+        {
+            if (workspace.allowed[m_targets[i]] && !workspace.visited[m_targets[i]])
+            {
+                stack.push_back(m_targets[i]);
+            }
+        }
+
+        frames.push_back({base, base});
+    }
+
+    // search stopped at the limit leaves its path marked
+    for (int node : workspace.path)
+    {
+        workspace.visited[node] = 0;
+    }
+}
+
+int CircumferenceSearch::restrict(int start, Workspace& workspace) const
+{
+    std::vector<int>& leaves = workspace.queue;
+    int count = 0;
+
+    leaves.clear();
+
+    for (int i = 0; i < m_degree; i++)
+    {
+        workspace.allowed[i] = i >= start;
+    }
+
+    for (int i = start; i < m_degree; i++)
+    {
+        // neighbour lists are ascending, so neighbours above start form their suffix
+        workspace.remaining[i] = m_offsets[i + 1] - static_cast<int>(std::lower_bound(
+            m_targets.begin() + m_offsets[i], m_targets.begin() + m_offsets[i + 1], start) - m_targets.begin());
+
+        if (workspace.remaining[i] < 2)
+        {
+            workspace.allowed[i] = 0;
+            leaves.push_back(i);
+        }
+    }
+
+    while (!leaves.empty())
+    {
+        const int leaf = leaves.back();
+        leaves.pop_back();
+
+        for (int i = m_offsets[leaf]; i < m_offsets[leaf + 1]; i++)
+        {
+            const int neighbour = m_targets[i];
+
+            if (workspace.allowed[neighbour] && --workspace.remaining[neighbour] < 2)
+            {
+                workspace.allowed[neighbour] = 0;
+                leaves.push_back(neighbour);
+            }
+        }
+    }
+
+    for (int i = start; i < m_degree; i++)
+    {
+        count += workspace.allowed[i];
+    }
+
+    return count;
+}
+
+int CircumferenceSearch::reachable(int start, Workspace& workspace) const
+{
+    const int stamp = ++workspace.stamp;
+    const int end = workspace.path.back();
+    const int second = workspace.path[1];
+    std::vector<int>& queue = workspace.queue;
+    std::vector<int>& leaves = workspace.leaves;
+
+    queue.assign(1, end);
+    leaves.clear();
+    workspace.marks[end] = stamp;
+
+    for (int head = 0; head < static_cast<int>(queue.size()); head++)
+    {
+        const int node = queue[head];
+
+        for (int i = m_offsets[node]; i < m_offsets[node + 1]; i++)
+        {
+            const int next = m_targets[i];
+
+            if (workspace.allowed[next] && !workspace.visited[next] && workspace.marks[next] != stamp)
+            {
+                workspace.marks[next] = stamp;
+                queue.push_back(next);
+            }
+        }
+    }
+
+    // inner node of extension needs two neighbours among reachable nodes and path end, last one needs start
+    // circle is closed by node above second node of path, the reverse circle is found from there
+    for (int head = 1; head < static_cast<int>(queue.size()); head++)
+    {
+        const int node = queue[head];
+        int& degree = workspace.remaining[node];
+
+        degree = 0;
+
+        for (int i = m_offsets[node]; i < m_offsets[node + 1]; i++)
+        {
+            const int next = m_targets[i];
+
+            degree += workspace.marks[next] == stamp || (next == start && node > second);
+        }
+
+        if (degree < 2)
+        {
+            leaves.push_back(node);
+        }
+    }
+
+    while (!leaves.empty())
+    {
+        const int leaf = leaves.back();
+        leaves.pop_back();
+        workspace.marks[leaf] = 0;
+
+        for (int i = m_offsets[leaf]; i < m_offsets[leaf + 1]; i++)
+        {
+            const int next = m_targets[i];
+
+            if (next != end && workspace.marks[next] == stamp && workspace.remaining[next]-- == 2)
+            {
+                leaves.push_back(next);
+            }
+        }
+    }
+
+    int count = 0;
+    bool closing = false;
+
+    for (int head = 1; head < static_cast<int>(queue.size()); head++)
+    {
+        const int node = queue[head];
+
+        if (workspace.marks[node] == stamp)
+        {
+            count++;
+            closing = closing || (node > second && std::binary_search(
+                m_targets.begin() + m_offsets[node], m_targets.begin() + m_offsets[node + 1], start));
+        }
+    }
+
+    if (!closing)
+    {
+        return 0;
+    }
+
+    // nodes of independent set are never consecutive on extension, which ends by one of them at most
+    int independent = 0;
+
+    for (int head = 1; head < static_cast<int>(queue.size()); head++)
+    {
+        const int node = queue[head];
+
+        if (workspace.marks[node] != stamp || workspace.remaining[node] < 0)
+        {
+            continue;
+        }
+
+        independent++;
+
+        for (int i = m_offsets[node]; i < m_offsets[node + 1]; i++)
+        {
+            workspace.remaining[m_targets[i]] = -1;
+        }
+    }
+
+    return std::min(count, 2 * (count - independent) + 1);
+}
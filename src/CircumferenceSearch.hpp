@@ -0,0 +1,113 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <vector>
+#include "Graph.hpp"
+
+/**
+ * Branch and bound search for the longest circle of graph
+ * Every circle is searched from its lowest node within nodes above it, start nodes are processed in parallel
+ * Pruning:
+ *  - nodes outside of 2-core of nodes above start lie on no such circle
+ *  - path together with nodes reachable from its end has to be longer than the best circle found
+ *  - reachable node counts only with two neighbours among reachable nodes, path end and start
+ *  - extension takes at most one more node of independent set of reachable nodes than nodes outside of it
+ *  - some reachable node above second node of path has to be adjacent to start, circle is searched in one direction
+ */
+class CircumferenceSearch
+{
+
+protected:
+
+    /**
+     * Per thread state of search from single start
+     */
+    struct Workspace
+    {
+        std::vector<char> allowed;
+        std::vector<char> visited;
+        std::vector<int> remaining;
+        std::vector<int> path;
+        std::vector<int> marks;
+        std::vector<int> queue;
+        std::vector<int> leaves;
+        int stamp = 0;
+    };
+
+    int m_degree;
+    std::vector<int> m_offsets;
+    std::vector<int> m_targets;
+
+public:
+
+    /**
+     * Constructor by graph
+     * @param graph
+     */
+    explicit CircumferenceSearch(const Graph& graph);
+
+public:
+
+    /**
+     * Returns length of the longest circle, zero for acyclic graph
+     * @param bound length of circle known to exist, search only looks for longer ones
+     * @param limit length no circle exceeds, search stops once circle of this length is found
+     * @return
+     */
+    int find(int bound = 0, int limit = std::numeric_limits<int>::max()) const;
+
+protected:
+
+    /**
+     * Returns upper bound of circle length given by greedily found independent set I
+     * Nodes of I are never consecutive on circle, so circle has at most as many nodes of I as others, 2 * (n - |I|)
+     * @return
+     */
+    int independentBound() const;
+
+    /**
+     * Searches circles whose lowest node is given start and raises shared best bound
+     * @param start
+     * @param best
+     * @param limit
+     * @param workspace
+     */
+    void searchFrom(int start, std::atomic<int>& best, int limit, Workspace& workspace) const;
+
+    /**
+     * Marks allowed nodes above start which belong to 2-core of nodes above start
+     * @param start
+     * @param workspace
+     * @return number of allowed nodes
+     */
+    int restrict(int start, Workspace& workspace) const;
+
+    /**
+     * Returns number of allowed nodes outside of path reachable from path end which may extend it to circle,
+     * or zero when none of them may close the circle
+     * @param start
+     * @param workspace
+     * @return
+     */
+    int reachable(int start, Workspace& workspace) const;
+};
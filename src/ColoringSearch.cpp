@@ -0,0 +1,368 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+
+#include <algorithm>
+#include "ColoringSearch.hpp"
+#include "BitKernels.hpp"
+
+ColoringSearch::ColoringSearch(const Graph& graph) :
+    m_graph(graph),
+    m_degree(graph.getDegree())
+{
+}
+
+int ColoringSearch::find(std::vector<int>& coloring)
+{
+    coloring.assign(m_degree, 0);
+
+    if (m_degree == 0)
+    {
+        return 0;
+    }
+
+    if (m_graph.getSize() == 0)
+    {
+        return 1;
+    }
+
+    if (twoColor(coloring))
+    {
+        return 2;
+    }
+
+    // branching needs neighbourhoods as bitsets, sparse graph is converted
+    if (m_graph.isSparse())
+    {
+        m_ownMatrix = m_graph.getSparseMatrix().toBitMatrix();
+        m_matrix = &m_ownMatrix;
+    }
+    else
+    {
+        m_matrix = &m_graph.getMatrix();
+    }
+
+    m_words = m_matrix->words();
+    m_classes.assign(static_cast<std::size_t>(m_degree) * m_words, 0);
+    m_uncolored.assign(m_words, ~Word(0));
+    m_saturation.assign(m_degree, 0);
+    m_colors.assign(m_degree, -1);
+
+    if (m_degree % BitMatrix::WORD_BITS)
+    {
+        m_uncolored[m_words - 1] = (Word(1) << (m_degree % BitMatrix::WORD_BITS)) - 1;
+    }
+
+    // clique nodes need distinct colors in every coloring, fixing them removes symmetric branches
+    const std::vector<int> clique = greedyClique();
+    const int lower = static_cast<int>(clique.size());
+
+    for (int i = 0; i < lower; i++)
+    {
+        assign(clique[i], i);
+    }
+
+    // greedy coloring never needs more than maximal degree plus one colors
+    int best = m_graph.getMaxDegree() + 2;
+
+    struct Frame
+    {
+        int node;
+        int used;
+        int color;
+        int next;
+    };
+
+    std::vector<Frame> frames;
+    const int first = select();
+
+    if (first == -1)
+    {
+        coloring.assign(m_colors.begin(), m_colors.end());
+        return lower;
+    }
+
+    frames.push_back({first, lower, -1, 0});
+
+    while (!frames.empty() && best > lower)
+    {
+        Frame& frame = frames.back();
+
+        if (frame.color != -1)
+        {
+            unassign(frame.node, frame.color);
+            frame.color = -1;
+        }
+
+        // existing colors first, new color only while it still beats the best coloring
+        int color = frame.next;
+
+        while (color < frame.used && blocked(frame.node, color))
+        {
+            color++;
+        }
+
+        if (color > frame.used || std::max(frame.used, color + 1) >= best)
+        {
+            frames.pop_back();
+            continue;
+        }
+
+        frame.color = color;
+        frame.next = color + 1;
+        assign(frame.node, color);
+
+        // neighbour seeing every color of better coloring cannot be colored at all
+        if (saturated(frame.node, best - 1))
+        {
+            continue;
+        }
+
+        const int used = std::max(frame.used, color + 1);
+        const int node = select();
+
+        if (node == -1)
+        {
+            best = used;
+            coloring.assign(m_colors.begin(), m_colors.end());
+            continue;
+        }
+
+        frames.push_back({node, used, -1, 0});
+    }
+
+    return best;
+}
+
+bool ColoringSearch::twoColor(std::vector<int>& coloring) const
+{
+    std::vector<int> queue;
+
+    coloring.assign(m_degree, -1);
+
+    for (int i = 0; i < m_degree; i++)
+    {
+        if (coloring[i] != -1)
+        {
+            continue;
+        }
+
+        coloring[i] = 0;
+        queue.assign(1, i);
+
+        for (int head = 0; head < static_cast<int>(queue.size()); head++)
+        {
+            const int node = queue[head];
+
+            for (int neighbour : m_graph.getNodeNeighbourRange(node))
+            {
+                if (coloring[neighbour] == -1)
+                {
+                    coloring[neighbour] = 1 - coloring[node];
+                    queue.push_back(neighbour);
+                }
+                else if (coloring[neighbour] == coloring[node])
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+std::vector<int> ColoringSearch::greedyClique() const
+{
+    static constexpr int MAX_STARTS = 256;
+
+    std::vector<int> order(m_degree);
+    std::vector<int> best;
+    std::vector<int> clique;
+    std::vector<Word> candidates(m_words);
+
+    for (int i = 0; i < m_degree; i++)
+    {
+        order[i] = i;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        return m_graph.getNodeDegree(a) > m_graph.getNodeDegree(b);
+    });
+
+    for (int s = 0; s < m_degree && s < MAX_STARTS; s++)
+    {
+        // clique cannot outgrow degree of its start
+        if (m_graph.getNodeDegree(order[s]) < static_cast<int>(best.size()))
+        {
+            break;
+        }
+
+        clique.assign(1, order[s]);
+        std::copy(m_matrix->row(order[s]), m_matrix->row(order[s]) + m_words, candidates.begin());
+
+        // candidate with most candidate neighbours keeps most room for further growth
+        while (true)
+        {
+            int chosen = -1;
+            int chosenCount = -1;
+
+            for (int w = 0; w < m_words; w++)
+            {
+                for (Word rest = candidates[w]; rest; rest &= rest - 1)
+                {
+                    const int node = w * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(rest);
+                    const int count = BitKernels::intersectionCount(m_matrix->row(node), candidates.data(), m_words);
+
+                    if (count > chosenCount)
+                    {
+                        chosen = node;
+                        chosenCount = count;
+                    }
+                }
+            }
+
+            if (chosen == -1)
+            {
+                break;
+            }
+
+            clique.push_back(chosen);
+            BitKernels::intersect(candidates.data(), candidates.data(), m_matrix->row(chosen), m_words);
+        }
+
+        if (clique.size() > best.size())
+        {
+            best = clique;
+        }
+    }
+
+    return best;
+}
+
+void ColoringSearch::assign(int node, int color) noexcept
+{
+    Word* colorClass = m_classes.data() + static_cast<std::size_t>(color) * m_words;
+    const Word* row = m_matrix->row(node);
+
+    m_uncolored[node / BitMatrix::WORD_BITS] &= ~(Word(1) << (node % BitMatrix::WORD_BITS));
+
+    // neighbour gains saturation when color is new in its neighbourhood
+    for (int w = 0; w < m_words; w++)
+    {
+        for (Word rest = row[w] & m_uncolored[w]; rest; rest &= rest - 1)
+        {
+            const int neighbour = w * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(rest);
+
+            if (!blocked(neighbour, color))
+            {
+                m_saturation[neighbour]++;
+            }
+        }
+    }
+
+    colorClass[node / BitMatrix::WORD_BITS] |= Word(1) << (node % BitMatrix::WORD_BITS);
+    m_colors[node] = color;
+}
+
+void ColoringSearch::unassign(int node, int color) noexcept
+{
+    Word* colorClass = m_classes.data() + static_cast<std::size_t>(color) * m_words;
+    const Word* row = m_matrix->row(node);
+
+    colorClass[node / BitMatrix::WORD_BITS] &= ~(Word(1) << (node % BitMatrix::WORD_BITS));
+    m_colors[node] = -1;
+
+    for (int w = 0; w < m_words; w++)
+    {
+        for (Word rest = row[w] & m_uncolored[w]; rest; rest &= rest - 1)
+        {
+            const int neighbour = w * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(rest);
+
+            if (!blocked(neighbour, color))
+            {
+                m_saturation[neighbour]--;
+            }
+        }
+    }
+
+    m_uncolored[node / BitMatrix::WORD_BITS] |= Word(1) << (node % BitMatrix::WORD_BITS);
+}
+
+int ColoringSearch::select() const noexcept
+{
+    int chosen = -1;
+    int chosenDegree = -1;
+
+    for (int w = 0; w < m_words; w++)
+    {
+        for (Word rest = m_uncolored[w]; rest; rest &= rest - 1)
+        {
+            const int node = w * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(rest);
+
+            if (chosen != -1 && m_saturation[node] < m_saturation[chosen])
+            {
+                continue;
+            }
+
+            const int degree = BitKernels::intersectionCount(m_matrix->row(node), m_uncolored.data(), m_words);
+
+            if (chosen == -1 || m_saturation[node] > m_saturation[chosen] || degree > chosenDegree)
+            {
+                chosen = node;
+                chosenDegree = degree;
+            }
+        }
+    }
+
+    return chosen;
+}
+
+bool ColoringSearch::saturated(int node, int limit) const noexcept
+{
+    const Word* row = m_matrix->row(node);
+
+    for (int w = 0; w < m_words; w++)
+    {
+        for (Word rest = row[w] & m_uncolored[w]; rest; rest &= rest - 1)
+        {
+            if (m_saturation[w * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(rest)] >= limit)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool ColoringSearch::blocked(int node, int color) const noexcept
+{
+    const Word* colorClass = m_classes.data() + static_cast<std::size_t>(color) * m_words;
+    const Word* row = m_matrix->row(node);
+
+    for (int w = 0; w < m_words; w++)
+    {
+        if (row[w] & colorClass[w])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
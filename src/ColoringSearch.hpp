@@ -0,0 +1,118 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+
+#pragma once
+
+#include <vector>
+#include "BitMatrix.hpp"
+#include "Graph.hpp"
+
+/**
+ * Exact vertex coloring by DSATUR branch and bound (Brelaz)
+ * Nodes of greedily found clique get distinct colors first, the clique size is lower bound
+ * Node with most distinct colors among neighbours is colored next, ties broken by most uncolored neighbours
+ * First descent of the search is greedy DSATUR coloring and gives initial upper bound
+ * Color classes are kept as node bitsets, so color is available when class misses whole neighbourhood
+ */
+class ColoringSearch
+{
+
+protected:
+
+    using Word = BitMatrix::Word;
+
+    const Graph& m_graph;
+    BitMatrix m_ownMatrix;
+    const BitMatrix* m_matrix = nullptr;
+    int m_degree;
+    int m_words = 0;
+
+    std::vector<Word> m_classes;
+    std::vector<Word> m_uncolored;
+    std::vector<int> m_saturation;
+    std::vector<int> m_colors;
+
+public:
+
+    /**
+     * Constructor by graph
+     * @param graph
+     */
+    explicit ColoringSearch(const Graph& graph);
+
+public:
+
+    /**
+     * Returns chromatic number and stores color of every node, numbered from zero, into coloring
+     * @param coloring
+     * @return
+     */
+    int find(std::vector<int>& coloring);
+
+protected:
+
+    /**
+     * Colors graph by two colors if it is bipartite
+     * @param coloring
+     * @return false when graph contains odd circle
+     */
+    bool twoColor(std::vector<int>& coloring) const;
+
+    /**
+     * Returns nodes of clique grown greedily from nodes of highest degree
+     * @return
+     */
+    std::vector<int> greedyClique() const;
+
+    /**
+     * Gives color to node and raises saturation of its uncolored neighbours
+     * @param node
+     * @param color
+     */
+    void assign(int node, int color) noexcept;
+
+    /**
+     * Takes color from node and lowers saturation of its uncolored neighbours
+     * @param node
+     * @param color
+     */
+    void unassign(int node, int color) noexcept;
+
+    /**
+     * Returns uncolored node of highest saturation, or -1 when all nodes are colored
+     * @return
+     */
+    int select() const noexcept;
+
+    /**
+     * Returns whether some uncolored neighbour of node sees at least given number of colors
+     * @param node
+     * @param limit
+     * @return
+     */
+    bool saturated(int node, int limit) const noexcept;
+
+    /**
+     * Returns whether node has neighbour of given color
+     * @param node
+     * @param color
+     * @return
+     */
+    bool blocked(int node, int color) const noexcept;
+};
@@ -16,71 +16,197 @@
 /* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
 /*                                                                          */
 
+#include <algorithm>
 #include "Graph.hpp"
 
-void Graph::computeProperties() noexcept
+Graph::Graph(int nodeCount, const std::vector<std::pair<int, int>>& edges, GraphRepresentation representation,
+             std::pmr::memory_resource* resource) :
+    m_solver(createSolver(resource)),
+    m_matrix(resource),
+    m_sparseMatrix(resource),
+    m_degrees(resource),
+    m_degreeCounts(resource),
+    m_sortedDegrees(resource)
 {
-    std::vector<int> degrees;
-    degrees.reserve(m_matrix.size());
+    if (representation == GraphRepresentation::AUTO)
+    {
+        const std::size_t denseUsage =
+            static_cast<std::size_t>(nodeCount) * BitMatrix::wordCount(nodeCount) * sizeof(BitMatrix::Word);
 
-    int maxDegree = 0;
-    int minDegree = m_matrix.size();
-    int doubleSize = 0;
+        representation = SparseMatrix::memoryUsage(nodeCount, edges.size()) < denseUsage
+            ? GraphRepresentation::SPARSE
+            : GraphRepresentation::DENSE;
+    }
 
-    for (auto& row : m_matrix)
+    m_sparse = representation == GraphRepresentation::SPARSE;
+
+    if (m_sparse)
+    {
+        m_sparseMatrix = SparseMatrix(nodeCount, edges, resource);
+    }
+    else
     {
-        int degree = 0;
+        m_matrix = BitMatrix(nodeCount, resource);
 
-        for (bool val : row)
+        for (auto& edge : edges)
         {
-            degree += static_cast<int>(val);
+            if (edge.first != edge.second)
+            {
+                m_matrix.set(edge.first, edge.second);
+                m_matrix.set(edge.second, edge.first);
+            }
         }
+    }
+
+    computeProperties();
+}
+
+void Graph::computeProperties() noexcept
+{
+    m_degrees.resize(getDegree());
+    m_degreeCounts.assign(getDegree() + 1, 0);
+    m_sortedDegreesValid = false;
+
+    int maxDegree = 0;
+    int minDegree = getDegree();
+    int doubleSize = 0;
 
-        degrees.push_back(degree);
+    for (int i = 0; i < getDegree(); i++)
+    {
+        const int degree = m_sparse ? m_sparseMatrix.rowCount(i) : m_matrix.rowCount(i);
+
+        m_degrees[i] = degree;
+        m_degreeCounts[degree]++;
         maxDegree = std::max(degree, maxDegree);
         minDegree = std::min(degree, minDegree);
         doubleSize += degree;
     }
 
-    m_degrees = degrees;
     m_maxDegree = maxDegree;
     m_minDegree = minDegree;
     m_size = doubleSize / 2;
 }
 
-Graph Graph::induced(const std::vector<int>& nodeIndices) const noexcept
+Graph Graph::induced(const std::vector<int>& nodeIndices, std::pmr::memory_resource* resource) const noexcept
 {
-    std::vector<std::vector<bool>> matrix;
-    matrix.reserve(nodeIndices.size());
+    if (m_sparse)
+    {
+        std::vector<int> position(getDegree(), -1);
+        std::vector<std::pair<int, int>> edges;
+
+        for (int i = 0; i < static_cast<int>(nodeIndices.size()); i++)
+        {
+            position[nodeIndices[i]] = i;
+        }
+
+        for (int i = 0; i < static_cast<int>(nodeIndices.size()); i++)
+        {
+            const int* end = m_sparseMatrix.rowEnd(nodeIndices[i]);
 
-    for (int i : nodeIndices)
+            for (const int* j = m_sparseMatrix.rowBegin(nodeIndices[i]); j != end; j++)
+            {
+                if (position[*j] > i)
+                {
+                    edges.emplace_back(i, position[*j]);
+                }
+            }
+        }
+
+        return Graph(nodeIndices.size(), edges, GraphRepresentation::AUTO, resource);
+    }
+
+    BitMatrix matrix(nodeIndices.size(), resource);
+
+    for (int i = 0; i < static_cast<int>(nodeIndices.size()); i++)
     {
-        std::vector<bool> row;
-        row.reserve(nodeIndices.size());
+        for (int j = 0; j < static_cast<int>(nodeIndices.size()); j++)
+        {
+            if (m_matrix.get(nodeIndices[i], nodeIndices[j]))
+            {
+                matrix.set(i, j);
+            }
+        }
+    }
 
-        for (int j : nodeIndices)
+    return Graph(std::move(matrix), resource);
+}
+
+const std::pmr::vector<int>& Graph::getSortedDegrees() const noexcept
+{
+    if (!m_sortedDegreesValid)
+    {
+        m_sortedDegrees.clear();
+
+        for (int degree = 0; degree < static_cast<int>(m_degreeCounts.size()); degree++)
         {
-            row.push_back(m_matrix[i][j]);
+            m_sortedDegrees.insert(m_sortedDegrees.end(), m_degreeCounts[degree], degree);
         }
 
-        matrix.push_back(row);
+        m_sortedDegreesValid = true;
     }
 
-    return Graph(matrix);
+    return m_sortedDegrees;
 }
 
 std::vector<int> Graph::getNodeNeighbours(int index) const noexcept
 {
-    std::vector<int> neighbours;
-    neighbours.reserve(getNodeDegree(index));
+    const NeighbourRange range = getNodeNeighbourRange(index);
+
+    return std::vector<int>(range.begin(), range.end());
+}
+
+std::vector<int> Graph::getCutVertices() const noexcept
+{
+    std::vector<int> blockCounts(getDegree(), 0);
+    std::vector<int> cutVertices;
+
+    for (auto& block : getBlocks())
+    {
+        for (int node : block)
+        {
+            blockCounts[node]++;
+        }
+    }
 
     for (int i = 0; i < getDegree(); i++)
     {
-        if (m_matrix[index][i])
+        if (blockCounts[i] > 1)
         {
-            neighbours.push_back(i);
+            cutVertices.push_back(i);
         }
     }
 
-    return neighbours;
+    return cutVertices;
+}
+
+bool Graph::isHamiltonRoute(const std::vector<int>& route) const noexcept
+{
+    if (static_cast<int>(route.size()) != getDegree() || route.empty())
+    {
+        return false;
+    }
+
+    std::vector<bool> visited(getDegree(), false);
+
+    for (int i = 0; i < static_cast<int>(route.size()); i++)
+    {
+        if (route[i] < 0 || route[i] >= getDegree() || visited[route[i]])
+        {
+            return false;
+        }
+
+        if (i > 0 && !hasEdge(route[i - 1], route[i]))
+        {
+            return false;
+        }
+
+        visited[route[i]] = true;
+    }
+
+    return true;
+}
+
+bool Graph::isHamiltonCircle(const std::vector<int>& circle) const noexcept
+{
+    return circle.size() >= 3 && isHamiltonRoute(circle) && hasEdge(circle.back(), circle.front());
 }
@@ -18,9 +18,16 @@
  
 #pragma once
 
+#include <chrono>
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <utility>
+#include "BitMatrix.hpp"
+#include "GraphRepresentation.hpp"
 #include "GraphSolver.hpp"
+#include "NeighbourRange.hpp"
+#include "SparseMatrix.hpp"
 #include "SmartGraphSolver.hpp"
 
 class Graph
@@ -28,10 +35,29 @@ class Graph
 
 protected:
 
-    std::unique_ptr<GraphSolver> m_solver;
-
-    std::vector<std::vector<bool>> m_matrix;
-    std::vector<int> m_degrees;
+    /**
+     * Deleter of solver placed into graphs memory resource
+     */
+    struct SolverDeleter
+    {
+        std::pmr::memory_resource* m_resource;
+
+        void operator()(GraphSolver* solver) const noexcept
+        {
+            solver->~GraphSolver();
+            m_resource->deallocate(solver, sizeof(SmartGraphSolver), alignof(SmartGraphSolver));
+        }
+    };
+
+    std::unique_ptr<GraphSolver, SolverDeleter> m_solver;
+
+    bool m_sparse;
+    BitMatrix m_matrix;
+    SparseMatrix m_sparseMatrix;
+    std::pmr::vector<int> m_degrees;
+    std::pmr::vector<int> m_degreeCounts;
+    mutable std::pmr::vector<int> m_sortedDegrees;
+    mutable bool m_sortedDegreesValid = false;
     int m_maxDegree;
     int m_minDegree;
     int m_size;
@@ -41,47 +67,131 @@ protected:
      */
     void computeProperties() noexcept;
 
+    /**
+     * Creates solver placed into given memory resource
+     * @param resource
+     * @return
+     */
+    std::unique_ptr<GraphSolver, SolverDeleter> createSolver(std::pmr::memory_resource* resource)
+    {
+        void* memory = resource->allocate(sizeof(SmartGraphSolver), alignof(SmartGraphSolver));
+
+        return std::unique_ptr<GraphSolver, SolverDeleter>(new (memory) SmartGraphSolver(this), SolverDeleter{resource});
+    }
+
 public:
 
     /**
      * Constructor by matrix
      * @param matrix
      */
-    explicit Graph(std::vector<std::vector<bool>> matrix) :
-        m_solver(std::make_unique<SmartGraphSolver>(this)),
-        m_matrix(std::move(matrix))
+    explicit Graph(const std::vector<std::vector<bool>>& matrix) :
+        Graph(BitMatrix(matrix))
+    {}
+
+    /**
+     * Constructor by bit matrix
+     * Solver and all storage are placed into given memory resource
+     * @param matrix
+     * @param resource
+     */
+    explicit Graph(BitMatrix matrix, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+        m_solver(createSolver(resource)),
+        m_sparse(false),
+        m_matrix(std::move(matrix), resource),
+        m_sparseMatrix(resource),
+        m_degrees(resource),
+        m_degreeCounts(resource),
+        m_sortedDegrees(resource)
+    {
+        computeProperties();
+    }
+
+    /**
+     * Constructor by compressed sparse row matrix
+     * Solver and all storage are placed into given memory resource
+     * @param matrix
+     * @param resource
+     */
+    explicit Graph(SparseMatrix matrix, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+        m_solver(createSolver(resource)),
+        m_sparse(true),
+        m_matrix(resource),
+        m_sparseMatrix(std::move(matrix), resource),
+        m_degrees(resource),
+        m_degreeCounts(resource),
+        m_sortedDegrees(resource)
     {
         computeProperties();
     }
 
+    /**
+     * Constructor by list of edges
+     * AUTO representation picks the one with smaller memory footprint
+     * @param nodeCount
+     * @param edges
+     * @param representation
+     * @param resource
+     */
+    Graph(int nodeCount, const std::vector<std::pair<int, int>>& edges,
+          GraphRepresentation representation = GraphRepresentation::AUTO,
+          std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
  public:
  
     /**
      * Generates new Graph instance representing subgraph induced by selected nodes
      * @param nodeIndices
+     * @param resource
      * @return
      */
-    Graph induced(const std::vector<int>& nodeIndices) const noexcept;
+    Graph induced(const std::vector<int>& nodeIndices,
+                  std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const noexcept;
 
  public:
 
     /**
-     * Returns matrix representation of graph
+     * Returns whether graph is stored in compressed sparse row representation
+     * @return
+     */
+    bool isSparse() const noexcept
+    {
+        return m_sparse;
+    }
+
+    /**
+     * Returns matrix representation of graph, empty for sparse graphs
      * @return
      */
-    const std::vector<std::vector<bool>>& getMatrix() const noexcept
+    const BitMatrix& getMatrix() const noexcept
     {
         return m_matrix;
     }
 
+    /**
+     * Returns compressed sparse row representation of graph, empty for dense graphs
+     * @return
+     */
+    const SparseMatrix& getSparseMatrix() const noexcept
+    {
+        return m_sparseMatrix;
+    }
+
     /**
      * Returns vector of node degrees
      * @return
      */
-    const std::vector<int>& getDegrees() const noexcept
+    const std::pmr::vector<int>& getDegrees() const noexcept
     {
         return m_degrees;
     }
+
+    /**
+     * Returns node degrees in ascending order
+     * Built from degree histogram in linear time and kept until graph is modified
+     * @return
+     */
+    const std::pmr::vector<int>& getSortedDegrees() const noexcept;
  
 public:
 
@@ -91,7 +201,7 @@ public:
      */
     int getDegree() const noexcept
     {
-        return m_matrix.size();
+        return m_sparse ? m_sparseMatrix.size() : m_matrix.size();
     }
 
     /**
@@ -111,7 +221,7 @@ public:
      */
     bool hasEdge(int index1, int index2) const noexcept
     {
-        return m_matrix[index1][index2];
+        return m_sparse ? m_sparseMatrix.get(index1, index2) : m_matrix.get(index1, index2);
     }
 
 public:
@@ -151,6 +261,36 @@ public:
      */
     std::vector<int> getNodeNeighbours(int index) const noexcept;
 
+    /**
+     * Returns range of indexes of neighbours of node at given index, iterated without allocation
+     * @param index
+     * @return
+     */
+    NeighbourRange getNodeNeighbourRange(int index) const noexcept
+    {
+        return m_sparse ? NeighbourRange(m_sparseMatrix, index) : NeighbourRange(m_matrix, index);
+    }
+
+public:
+
+    /**
+     * Returns number of scratch allocations made by last finished query
+     * @return
+     */
+    int getLastQueryAllocations() const noexcept
+    {
+        return m_solver->getArena().getLastQueryAllocations();
+    }
+
+    /**
+     * Returns number of scratch allocations which reached the heap during last finished query
+     * @return
+     */
+    int getLastQueryHeapAllocations() const noexcept
+    {
+        return m_solver->getArena().getLastQueryUpstreamAllocations();
+    }
+
 public:
 
     /**
@@ -159,6 +299,8 @@ public:
      */
     bool isContinuous() const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->isContinuous();
     }
 
@@ -168,6 +310,8 @@ public:
      */
     bool isLocallyContinuous() const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->isLocallyContinuous();
     }
 
@@ -177,6 +321,8 @@ public:
      */
     int getNodeContinuity() const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->getNodeContinuity();
     }
 
@@ -186,6 +332,8 @@ public:
      */
     int getEdgeContinuity() const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->getEdgeContinuity();
     }
 
@@ -196,6 +344,8 @@ public:
      */
     bool isKNodeContinuous(int k) const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->isKNodeContinuous(k);
     }
 
@@ -206,9 +356,63 @@ public:
      */
     bool isKEdgeContinuous(int k) const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->isKEdgeContinuous(k);
     }
 
+    /**
+     * Returns number of connected components
+     * @return
+     */
+    int getComponentCount() const noexcept
+    {
+        const ScratchArena::Scope query(m_solver->getArena());
+
+        return m_solver->getComponentCount();
+    }
+
+    /**
+     * Returns label of connected component of every node
+     * Components are numbered from zero in order of their lowest node
+     * @return
+     */
+    std::vector<int> getComponents() const noexcept
+    {
+        const ScratchArena::Scope query(m_solver->getArena());
+
+        return m_solver->getComponents();
+    }
+
+    /**
+     * Returns biconnected blocks, each as ascending list of its nodes
+     * Blocks together with cut vertices form block-cut tree, block is adjacent to cut vertices it contains
+     * @return
+     */
+    std::vector<std::vector<int>> getBlocks() const noexcept
+    {
+        const ScratchArena::Scope query(m_solver->getArena());
+
+        return m_solver->getBlocks();
+    }
+
+    /**
+     * Returns ascending list of nodes on one side of minimum edge cut, its size is edge continuity
+     * @return
+     */
+    std::vector<int> getMinimumCut() const noexcept
+    {
+        const ScratchArena::Scope query(m_solver->getArena());
+
+        return m_solver->getMinimumCut();
+    }
+
+    /**
+     * Returns ascending list of cut vertices, nodes shared by more than one block
+     * @return
+     */
+    std::vector<int> getCutVertices() const noexcept;
+
 public:
 
     /*
@@ -221,6 +425,8 @@ public:
      */
     int getCircumference() const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->getCircumference();
     }
 
@@ -230,6 +436,8 @@ public:
      */
     int getGirth() const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->getGirth();
     }
 
@@ -239,6 +447,8 @@ public:
      */
     bool hasClaw() const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->hasClaw();
     }
 
@@ -248,6 +458,8 @@ public:
      */
     bool isClaw() const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->isClaw();
     }
 
@@ -257,6 +469,8 @@ public:
      */
     bool isComplete() const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->isComplete();
     }
 
@@ -272,6 +486,8 @@ public:
      */
     bool hasHamiltonRoute() const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->hasHamiltonRoute();
     }
 
@@ -281,9 +497,57 @@ public:
      */
     bool hasHamiltonCircle() const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->hasHamiltonCircle();
     }
 
+    /**
+     * Returns order of nodes of some Hamilton route, empty if there is none
+     * @return
+     */
+    std::vector<int> getHamiltonRoute() const noexcept
+    {
+        const ScratchArena::Scope query(m_solver->getArena());
+
+        return m_solver->getHamiltonRoute();
+    }
+
+    /**
+     * Returns order of nodes of some Hamilton circle, empty if there is none
+     * @return
+     */
+    std::vector<int> getHamiltonCircle() const noexcept
+    {
+        const ScratchArena::Scope query(m_solver->getArena());
+
+        return m_solver->getHamiltonCircle();
+    }
+
+    /**
+     * Sets budget of randomized search run before exact Hamilton checks, zero iterations disable it
+     * @param iterations
+     * @param time
+     */
+    void setHamiltonHeuristicBudget(int iterations, std::chrono::milliseconds time) noexcept
+    {
+        m_solver->setHeuristicBudget(iterations, time);
+    }
+
+    /**
+     * Returns whether given order of nodes forms Hamilton route of graph
+     * @param route
+     * @return
+     */
+    bool isHamiltonRoute(const std::vector<int>& route) const noexcept;
+
+    /**
+     * Returns whether given order of nodes forms Hamilton circle of graph
+     * @param circle
+     * @return
+     */
+    bool isHamiltonCircle(const std::vector<int>& circle) const noexcept;
+
 public:
 
     /*
@@ -296,6 +560,19 @@ public:
      */
     int getChromaticNumber() const noexcept
     {
+        const ScratchArena::Scope query(m_solver->getArena());
+
         return m_solver->getChromaticNumber();
     }
+
+    /**
+     * Returns color of every node in minimal coloring, colors are numbered from zero
+     * @return
+     */
+    std::vector<int> getColoring() const noexcept
+    {
+        const ScratchArena::Scope query(m_solver->getArena());
+
+        return m_solver->getColoring();
+    }
 };
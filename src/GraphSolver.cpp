@@ -17,10 +17,25 @@
 /*                                                                          */
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
 #include "GraphSolver.hpp"
 #include "Graph.hpp"
+#include "BitKernels.hpp"
+#include "CircumferenceSearch.hpp"
+#include "ColoringSearch.hpp"
+#include "HamiltonDP.hpp"
+#include "HamiltonSearch.hpp"
+#include "SmallGraph.hpp"
 #include "MutableGraph.hpp"
+#include "NodeFlowNetwork.hpp"
+#include "MinimumCut.hpp"
+#include "PosaHeuristic.hpp"
+#include "ThreadPool.hpp"
 
 bool GraphSolver::isContinuous() const noexcept
 {
@@ -44,12 +59,43 @@ int GraphSolver::getEdgeContinuity() const noexcept
 
 bool GraphSolver::isKNodeContinuous(int k) const noexcept
 {
-    return getNodeContinuity() >= k;
+    return bfKNodeContinuity(k);
 }
 
 bool GraphSolver::isKEdgeContinuous(int k) const noexcept
 {
-    return getEdgeContinuity() >= k;
+    return bfKEdgeContinuity(k);
+}
+
+int GraphSolver::getComponentCount() const noexcept
+{
+    std::vector<int> labels;
+
+    return bfComponents(labels);
+}
+
+std::vector<int> GraphSolver::getComponents() const noexcept
+{
+    std::vector<int> labels;
+    bfComponents(labels);
+
+    return labels;
+}
+
+std::vector<std::vector<int>> GraphSolver::getBlocks() const noexcept
+{
+    std::vector<std::vector<int>> blocks;
+    bfBlocks(blocks);
+
+    return blocks;
+}
+
+std::vector<int> GraphSolver::getMinimumCut() const noexcept
+{
+    std::vector<int> side;
+    bfEdgeContinuity(&side);
+
+    return side;
 }
 
 int GraphSolver::getCircumference() const noexcept
@@ -112,12 +158,37 @@ bool GraphSolver::hasHamiltonRoute() const noexcept
 
 bool GraphSolver::hasHamiltonCircle() const noexcept
 {
-    return dirac1952() || ore1960() || poza1963() || chvatal1972() || bondyChvatal1974() || oberlySummer1979() || bfHamiltonCircle();
+    // Dirac and Pósa conditions imply Chvátal one, which is evaluated from the same sorted degrees
+    return dirac1952() || chvatal1972() || ore1960() || bondyChvatal1974() || oberlySummer1979() || bfHamiltonCircle();
+}
+
+std::vector<int> GraphSolver::getHamiltonRoute() const noexcept
+{
+    std::vector<int> route;
+    bfHamiltonRoute(&route);
+
+    return route;
+}
+
+std::vector<int> GraphSolver::getHamiltonCircle() const noexcept
+{
+    std::vector<int> circle;
+    bfHamiltonCircle(&circle);
+
+    return circle;
 }
 
 int GraphSolver::getChromaticNumber() const noexcept
 {
-    return 0;
+    return bfChromaticNumber();
+}
+
+std::vector<int> GraphSolver::getColoring() const noexcept
+{
+    std::vector<int> coloring;
+    bfChromaticNumber(&coloring);
+
+    return coloring;
 }
 
 bool GraphSolver::chartrandPippert1974() const noexcept
@@ -154,53 +225,98 @@ bool GraphSolver::dirac1952() const noexcept
         return false;
     }
 
-    return m_graph->getMinDegree() >= std::ceil(m_graph->getDegree() / 2.0);
+    return 2 * m_graph->getMinDegree() >= m_graph->getDegree();
 }
 
 bool GraphSolver::ore1960() const noexcept
 {
-    for (int i = 0; i < m_graph->getDegree(); i++)
+    const int degree = m_graph->getDegree();
+    const std::pmr::vector<int>& sorted = m_graph->getSortedDegrees();
+
+    if (degree < 3)
     {
-        for (int j = i; j < m_graph->getDegree(); j++)
+        return false;
+    }
+
+    // every pair of nodes reaches the degree sum
+    if (sorted[0] + sorted[1] >= degree)
+    {
+        return true;
+    }
+
+    if (m_graph->isSparse())
+    {
+        // node fails when some node of too low degree is not among its neighbours
+        for (int i = 0; i < degree; i++)
         {
-            if (i == j)
+            const int limit = degree - m_graph->getNodeDegree(i);
+            int low = std::lower_bound(sorted.begin(), sorted.end(), limit) - sorted.begin();
+
+            if (m_graph->getNodeDegree(i) < limit)
             {
-                continue;
+                low--;
             }
 
-            if (!m_graph->hasEdge(i, j) &&
-                    m_graph->getNodeDegree(i) + m_graph->getNodeDegree(j) < m_graph->getDegree())
+            for (int neighbour : m_graph->getNodeNeighbourRange(i))
+            {
+                if (m_graph->getNodeDegree(neighbour) < limit)
+                {
+                    low--;
+                }
+            }
+
+            if (low > 0)
             {
                 return false;
             }
         }
+
+        return true;
     }
 
-    return false;
-}
+    // nodes by descending degree need growing limit, low degree nodes are collected into row
+    const BitMatrix& matrix = m_graph->getMatrix();
+    std::pmr::vector<int> order(degree, &m_arena);
+    std::pmr::vector<BitMatrix::Word> low(matrix.words(), 0, &m_arena);
+    std::pmr::vector<int> position(m_graph->getMaxDegree() + 2, 0, &m_arena);
 
-bool GraphSolver::poza1963() const noexcept
-{
-    if (m_graph->getDegree() < 3)
+    for (int i = 0; i < degree; i++)
     {
-        return false;
+        position[m_graph->getNodeDegree(i) + 1]++;
     }
 
-    for (int i  = 1; i <= std::floor(m_graph->getDegree() / 2.0); i++)
+    std::partial_sum(position.begin(), position.end(), position.begin());
+
+    for (int i = 0; i < degree; i++)
+    {
+        order[position[m_graph->getNodeDegree(i)]++] = i;
+    }
+
+    int added = 0;
+
+    for (int i = degree - 1; i >= 0; i--)
     {
-        int nodeCount = 0;
+        const int node = order[i];
+        const int limit = degree - m_graph->getNodeDegree(node);
 
-        for (int degree : m_graph->getDegrees())
+        for (; added < degree && m_graph->getNodeDegree(order[added]) < limit; added++)
         {
-            if (degree < i)
-            {
-                nodeCount += 1;
-            }
+            low[order[added] / BitMatrix::WORD_BITS] |= BitMatrix::Word(1) << (order[added] % BitMatrix::WORD_BITS);
         }
 
-        if (nodeCount >= i)
+        for (int w = 0; w < matrix.words(); w++)
         {
-            return false;
+            BitMatrix::Word missing = low[w] & ~matrix.row(node)[w];
+
+            if (w == node / BitMatrix::WORD_BITS)
+            {
+                missing &= ~(BitMatrix::Word(1) << (node % BitMatrix::WORD_BITS));
+            }
+
+            if (missing)
+            {
+                return false;
+            }
         }
     }
 
@@ -209,13 +325,17 @@ bool GraphSolver::poza1963() const noexcept
 
 bool GraphSolver::chvatal1972() const noexcept
 {
-    auto orderedDegree = m_graph->getDegrees();
-    std::sort(orderedDegree.begin(), orderedDegree.end());
+    const int degree = m_graph->getDegree();
+    const std::pmr::vector<int>& sorted = m_graph->getSortedDegrees();
+
+    if (degree < 3)
+    {
+        return false;
+    }
 
-    for (int i  = 1; i <= std::floor(m_graph->getDegree() / 2.0); i++)
+    for (int k = 1; 2 * k < degree; k++)
     {
-        if (orderedDegree[i - 1] < i + 1 ||
-            orderedDegree[m_graph->getDegree() - i - 1] < m_graph->getDegree() - i)
+        if (sorted[k - 1] <= k && sorted[degree - k - 1] < degree - k)
         {
             return false;
         }
@@ -231,27 +351,18 @@ bool GraphSolver::bondyChvatal1974() const noexcept
         return false;
     }
 
-    auto closure = MutableGraph(m_graph->getMatrix());
-    bool change = true;
-
-    while (change)
+    // closure cannot add any edge when no pair of nodes reaches the degree sum
+    if (2 * m_graph->getMaxDegree() < m_graph->getDegree())
     {
-        change = false;
+        return m_graph->isComplete();
+    }
 
-        for (int i = 0; i < m_graph->getDegree(); i++)
-        {
-            for (int j = 0; j < m_graph->getDegree(); j++)
-            {
-                if (i == j || closure.hasEdge(i, j) || closure.getNodeDegree(i) + closure.getNodeDegree(j) < closure.getDegree())
-                {
-                    continue;
-                }
+    MutableGraph closure(m_graph->isSparse()
+                             ? m_graph->getSparseMatrix().toBitMatrix(&m_arena)
+                             : BitMatrix(m_graph->getMatrix(), &m_arena),
+                         &m_arena);
 
-                closure.addEdge(i, j);
-                change = true;
-            }
-        }
-    }
+    closure.close(m_graph->getDegree());
 
     return closure.isComplete();
 }
@@ -261,110 +372,1083 @@ bool GraphSolver::oberlySummer1979() const noexcept
     return isContinuous() && isLocallyContinuous() && !hasClaw();
 }
 
-static void recursiveFn(int index, std::vector<bool>& search, const std::vector<std::vector<bool>>& matrix)
+bool GraphSolver::hamiltonObstruction(bool route) const noexcept
 {
-    search[index] = true;
-    for (int i = 0; i < matrix.size(); i++)
+    const int degree = m_graph->getDegree();
+
+    if (degree < (route ? 1 : 3))
+    {
+        return true;
+    }
+
+    if (degree == 1)
+    {
+        return false;
+    }
+
+    // route ends in nodes of degree one, circle has none
+    int leaves = 0;
+
+    for (int i = 0; i < degree; i++)
+    {
+        if (m_graph->getNodeDegree(i) == 0 || (m_graph->getNodeDegree(i) == 1 && (!route || ++leaves > 2)))
+        {
+            return true;
+        }
+    }
+
+    struct Frame
+    {
+        int node;
+        NeighbourIterator next;
+        NeighbourIterator end;
+    };
+
+    std::pmr::vector<Frame> stack(&m_arena);
+    std::pmr::vector<int> discovery(degree, -1, &m_arena);
+    std::pmr::vector<int> low(degree, 0, &m_arena);
+    std::pmr::vector<int> parent(degree, -1, &m_arena);
+    std::pmr::vector<int> depth(degree, 0, &m_arena);
+    std::pmr::vector<int> separated(degree, 0, &m_arena);
+    std::array<int, 2> sides {1, 0};
+    bool bipartite = true;
+    int time = 0;
+
+    discovery[0] = low[0] = time++;
+    stack.push_back({0, m_graph->getNodeNeighbourRange(0).begin(), m_graph->getNodeNeighbourRange(0).end()});
+
+    while (!stack.empty())
+    {
+        Frame& frame = stack.back();
+
+        if (frame.next == frame.end)
+        {
+            const int node = frame.node;
+            stack.pop_back();
+
+            if (parent[node] != -1)
+            {
+                low[parent[node]] = std::min(low[parent[node]], low[node]);
+
+                // subtree of node gets separated from the rest by removal of its parent
+                if (low[node] >= discovery[parent[node]])
+                {
+                    separated[parent[node]]++;
+                }
+            }
+
+            continue;
+        }
+
+        const int node = frame.node;
+        const int neighbour = *frame.next;
+        ++frame.next;
+
+        if (discovery[neighbour] == -1)
+        {
+            discovery[neighbour] = low[neighbour] = time++;
+            parent[neighbour] = node;
+            depth[neighbour] = depth[node] + 1;
+            sides[depth[neighbour] % 2]++;
+
+            const NeighbourRange range = m_graph->getNodeNeighbourRange(neighbour);
+            stack.push_back({neighbour, range.begin(), range.end()});
+        }
+        else if (neighbour != parent[node])
+        {
+            low[node] = std::min(low[node], discovery[neighbour]);
+
+            // parity of tree depth is the only possible two coloring
+            if (depth[node] % 2 == depth[neighbour] % 2)
+            {
+                bipartite = false;
+            }
+        }
+    }
+
+    if (time < degree)
     {
-        bool val = matrix[index][i];
+        return true;
+    }
 
-        if (val && search[i] != true)
+    // circle survives removal of any node in one piece, route in at most two
+    for (int i = 0; i < degree; i++)
+    {
+        if (separated[i] + (i == 0 ? 0 : 1) > (route ? 2 : 1))
         {
-            search[i] = true;
-            recursiveFn(i, search, matrix);
+            return true;
         }
     }
+
+    // nodes of circle alternate between sides, route may have one more node on one side
+    return bipartite && std::abs(sides[0] - sides[1]) > (route ? 1 : 0);
 }
 
 bool GraphSolver::bfContinuity() const noexcept
 {
-    std::vector<bool> search(m_graph->getDegree(), false);
+    if (m_graph->getDegree() <= SmallGraph<BitMatrix::WORD_BITS>::capacity())
+    {
+        return SmallGraph<BitMatrix::WORD_BITS>(*m_graph).isContinuous();
+    }
 
-    recursiveFn(0, search, m_graph->getMatrix());
+    std::vector<int> labels;
 
-    return std::find(search.begin(), search.end(), false) == search.end();
+    return bfComponents(labels) == 1;
 }
 
-bool GraphSolver::bfLocalContinuity() const noexcept
+int GraphSolver::bfComponents(std::vector<int>& labels) const noexcept
 {
-    // TODO subgraph algorithm
-    return false;
-}
+    const int degree = m_graph->getDegree();
+    int count = 0;
 
-int GraphSolver::bfNodeContinuity() const noexcept
-{
-    // TODO subgraph algorithm
-    return 0;
-}
+    labels.assign(degree, -1);
 
-int GraphSolver::bfEdgeContinuity() const noexcept
-{
-    // TODO subgraph algorithm
-    return 0;
+    if (m_graph->isSparse())
+    {
+        std::pmr::vector<int> queue(&m_arena);
+        queue.reserve(degree);
+
+        for (int i = 0; i < degree; i++)
+        {
+            if (labels[i] != -1)
+            {
+                continue;
+            }
+
+            labels[i] = count;
+            queue.assign(1, i);
+
+            for (int head = 0; head < static_cast<int>(queue.size()); head++)
+            {
+                for (int neighbour : m_graph->getNodeNeighbourRange(queue[head]))
+                {
+                    if (labels[neighbour] == -1)
+                    {
+                        labels[neighbour] = count;
+                        queue.push_back(neighbour);
+                    }
+                }
+            }
+
+            count++;
+        }
+
+        return count;
+    }
+
+    const BitMatrix& matrix = m_graph->getMatrix();
+    const int words = matrix.words();
+    std::pmr::vector<BitMatrix::Word> unvisited(words, ~BitMatrix::Word(0), &m_arena);
+    std::pmr::vector<BitMatrix::Word> frontier(words, 0, &m_arena);
+    std::pmr::vector<BitMatrix::Word> next(words, 0, &m_arena);
+
+    if (degree % BitMatrix::WORD_BITS)
+    {
+        unvisited[words - 1] = (BitMatrix::Word(1) << (degree % BitMatrix::WORD_BITS)) - 1;
+    }
+
+    for (int first = 0; first < words; )
+    {
+        if (!unvisited[first])
+        {
+            first++;
+            continue;
+        }
+
+        // lowest unvisited node starts next component
+        const int start = first * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(unvisited[first]);
+        bool growing = true;
+
+        std::fill(frontier.begin(), frontier.end(), 0);
+        frontier[first] = BitMatrix::Word(1) << (start % BitMatrix::WORD_BITS);
+        unvisited[first] &= ~frontier[first];
+        labels[start] = count;
+
+        while (growing)
+        {
+            growing = false;
+            std::fill(next.begin(), next.end(), 0);
+
+            for (int w = 0; w < words; w++)
+            {
+                for (BitMatrix::Word rest = frontier[w]; rest; rest &= rest - 1)
+                {
+                    BitKernels::unite(next.data(), next.data(), matrix.row(w * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(rest)), words);
+                }
+            }
+
+            // new frontier is what the old one reaches outside of visited nodes
+            BitKernels::intersect(frontier.data(), next.data(), unvisited.data(), words);
+            BitKernels::subtract(unvisited.data(), unvisited.data(), frontier.data(), words);
+
+            for (int w = 0; w < words; w++)
+            {
+                for (BitMatrix::Word rest = frontier[w]; rest; rest &= rest - 1)
+                {
+                    labels[w * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(rest)] = count;
+                    growing = true;
+                }
+            }
+        }
+
+        count++;
+    }
+
+    return count;
 }
 
-int GraphSolver::bfCircumference() const noexcept
+std::vector<int> GraphSolver::evaluateComponents(const std::function<int(const Graph&, int)>& property, bool cyclicOnly) const
 {
-    // TODO algorithm
-    return 0;
+    const std::vector<int> labels = getComponents();
+    std::vector<std::vector<int>> members(getComponentCount());
+    std::vector<int> doubleSizes(members.size(), 0);
+
+    for (int i = 0; i < m_graph->getDegree(); i++)
+    {
+        members[labels[i]].push_back(i);
+        doubleSizes[labels[i]] += m_graph->getNodeDegree(i);
+    }
+
+    // trees are skipped by clearing their node sets, their value stays zero
+    if (cyclicOnly)
+    {
+        for (int i = 0; i < static_cast<int>(members.size()); i++)
+        {
+            if (doubleSizes[i] / 2 == static_cast<int>(members[i].size()) - 1)
+            {
+                members[i].clear();
+            }
+        }
+    }
+
+    return evaluateSubgraphs(members, property);
 }
 
-int GraphSolver::bfGirth() const noexcept
+std::vector<int> GraphSolver::evaluateSubgraphs(const std::vector<std::vector<int>>& nodeSets,
+                                                const std::function<int(const Graph&, int)>& property) const
 {
-    // TODO algorithm
-    return 0;
+    std::vector<int> values(nodeSets.size(), 0);
+
+    // each task builds its own subgraph, so subgraphs share nothing but the read only parent
+    ThreadPool::instance().parallelFor(nodeSets.size(), [&](int index)
+    {
+        if (nodeSets[index].empty())
+        {
+            return;
+        }
+
+        const Graph subgraph = m_graph->induced(nodeSets[index]);
+        values[index] = property(subgraph, index);
+    });
+
+    return values;
 }
 
-bool GraphSolver::bfHasClaw() const noexcept
+void GraphSolver::bfBlocks(std::vector<std::vector<int>>& blocks) const noexcept
 {
-    if (m_graph->getDegree() < 4)
-    {
-        return false;
-    }
+    const int degree = m_graph->getDegree();
 
-    if (m_graph->getDegree() == 4)
+    struct Frame
     {
-        return m_graph->isClaw();
-    }
+        int node;
+        NeighbourIterator next;
+        NeighbourIterator end;
+    };
 
-    for (int i = 0; i < m_graph->getDegree(); i++)
+    std::pmr::vector<Frame> stack(&m_arena);
+    std::pmr::vector<int> nodes(&m_arena);
+    std::pmr::vector<int> discovery(degree, -1, &m_arena);
+    std::pmr::vector<int> low(degree, 0, &m_arena);
+    std::pmr::vector<int> parent(degree, -1, &m_arena);
+    int time = 0;
+
+    blocks.clear();
+
+    for (int root = 0; root < degree; root++)
     {
-        if (m_graph->getNodeDegree(i) < 3)
+        if (discovery[root] != -1)
         {
             continue;
         }
 
-        auto neighbours = m_graph->getNodeNeighbours(i);
+        if (m_graph->getNodeDegree(root) == 0)
+        {
+            discovery[root] = time++;
+            blocks.push_back({root});
+            continue;
+        }
+
+        const NeighbourRange rootRange = m_graph->getNodeNeighbourRange(root);
+        discovery[root] = low[root] = time++;
+        stack.push_back({root, rootRange.begin(), rootRange.end()});
+        nodes.assign(1, root);
 
-        // TODO better way to get all triplets
-        for (int j = 0; j < neighbours.size() - 2; j++)
+        while (!stack.empty())
         {
-            for (int k = 1; k < neighbours.size() - 1; k++)
+            Frame& frame = stack.back();
+
+            if (frame.next == frame.end)
             {
-                for (int l = 2; l < neighbours.size(); l++)
+                const int node = frame.node;
+                const int above = parent[node];
+                stack.pop_back();
+
+                if (above == -1)
+                {
+                    continue;
+                }
+
+                low[above] = std::min(low[above], low[node]);
+
+                // subtree of node hangs on its parent only, together they form a block
+                if (low[node] >= discovery[above])
                 {
-                    auto subgraph = m_graph->induced({i, neighbours[j], neighbours[k], neighbours[l]});
+                    blocks.emplace_back();
 
-                    if (subgraph.isClaw())
+                    do
                     {
-                        return true;
+                        blocks.back().push_back(nodes.back());
+                        nodes.pop_back();
                     }
+                    while (blocks.back().back() != node);
+
+                    blocks.back().push_back(above);
+                    std::sort(blocks.back().begin(), blocks.back().end());
                 }
+
+                continue;
+            }
+
+            const int node = frame.node;
+            const int neighbour = *frame.next;
+            ++frame.next;
+
+            if (discovery[neighbour] == -1)
+            {
+                const NeighbourRange range = m_graph->getNodeNeighbourRange(neighbour);
+                discovery[neighbour] = low[neighbour] = time++;
+                parent[neighbour] = node;
+                stack.push_back({neighbour, range.begin(), range.end()});
+                nodes.push_back(neighbour);
+            }
+            else if (neighbour != parent[node])
+            {
+                low[node] = std::min(low[node], discovery[neighbour]);
             }
         }
     }
-
-    return false;
 }
 
-bool GraphSolver::bfHamiltonRoute() const noexcept
+bool GraphSolver::bfLocalContinuity() const noexcept
 {
-    // TODO permutation algorithm
-    return true;
+    // TODO subgraph algorithm
+    return false;
 }
 
-bool GraphSolver::bfHamiltonCircle() const noexcept
+int GraphSolver::bfNodeContinuity(int bound) const noexcept
 {
-    // TODO permutation algorithm
-    return false;
+    const int degree = m_graph->getDegree();
+
+    if (degree <= 1 || !isContinuous())
+    {
+        return 0;
+    }
+
+    if (2 * static_cast<long long>(m_graph->getSize()) == static_cast<long long>(degree) * (degree - 1))
+    {
+        return degree - 1;
+    }
+
+    // node continuity never exceeds minimal degree nor edge continuity
+    const int upper = std::min(m_graph->getMinDegree(), bound);
+    std::vector<std::vector<int>> blocks;
+    bfBlocks(blocks);
+
+    // connected graph with cut vertex, otherwise at least biconnected
+    if (blocks.size() > 1)
+    {
+        return 1;
+    }
+
+    if (upper <= 2)
+    {
+        return upper;
+    }
+
+    return bfBoundedNodeContinuity(upper, 2);
+}
+
+bool GraphSolver::bfKNodeContinuity(int k) const noexcept
+{
+    const int degree = m_graph->getDegree();
+
+    if (k <= 0)
+    {
+        return true;
+    }
+
+    // complete graph of degree n is n - 1 continuous, any other needs k + 2 nodes
+    if (degree <= k || m_graph->getMinDegree() < k || !isContinuous())
+    {
+        return false;
+    }
+
+    if (k == 1)
+    {
+        return true;
+    }
+
+    // biconnectivity is decided by single block decomposition
+    if (k == 2)
+    {
+        std::vector<std::vector<int>> blocks;
+        bfBlocks(blocks);
+
+        return blocks.size() == 1;
+    }
+
+    return bfBoundedNodeContinuity(k, k - 1) >= k;
+}
+
+int GraphSolver::bfBoundedNodeContinuity(int k, int lower) const noexcept
+{
+    const int degree = m_graph->getDegree();
+
+    // Even: first k scanned nodes must not be separable, every later node needs fan of k paths to earlier ones
+    std::vector<int> order;
+    const Graph certificate(degree, MinimumCut::certificate(*m_graph, k, &order), GraphRepresentation::SPARSE);
+    std::vector<int> ranks(degree);
+    std::vector<std::pair<int, int>> checks;
+
+    for (int i = 0; i < degree; i++)
+    {
+        ranks[order[i]] = i;
+    }
+
+    for (int i = 0; i < k; i++)
+    {
+        for (int j = i + 1; j < k; j++)
+        {
+            if (!certificate.hasEdge(order[i], order[j]))
+            {
+                checks.emplace_back(order[i], order[j]);
+            }
+        }
+    }
+
+    // node with k earlier neighbours has trivial fan, scanning leaves only few nodes without
+    for (int i = k; i < degree; i++)
+    {
+        int earlier = 0;
+
+        for (int neighbour : certificate.getNodeNeighbourRange(order[i]))
+        {
+            earlier += ranks[neighbour] < i;
+        }
+
+        if (earlier < k)
+        {
+            checks.emplace_back(order[i], -1);
+        }
+    }
+
+    // every check is bounded below by node continuity and the one crossing minimal separator reaches it
+    const NodeFlowNetwork network(certificate);
+    ThreadPool& pool = ThreadPool::instance();
+    const int chunks = std::min(static_cast<int>(checks.size()), 4 * pool.getThreadCount());
+    std::atomic<int> best(k);
+
+    pool.parallelFor(chunks, [&](int chunk)
+    {
+        NodeFlowNetwork::Workspace workspace;
+
+        for (int i = chunk; i < static_cast<int>(checks.size()) && best > lower; i += chunks)
+        {
+            const int limit = best;
+            const int paths = checks[i].second == -1
+                ? network.countFanPaths(checks[i].first, ranks, ranks[checks[i].first], limit, workspace)
+                : network.countPaths(checks[i].first, checks[i].second, limit, workspace);
+            int current = best;
+
+            while (paths < current && !best.compare_exchange_weak(current, paths))
+            {
+            }
+        }
+    });
+
+    return best;
+}
+
+int GraphSolver::bfEdgeContinuity(std::vector<int>* side) const noexcept
+{
+    MinimumCut cut(*m_graph);
+
+    return cut.compute(side);
+}
+
+bool GraphSolver::bfKEdgeContinuity(int k) const noexcept
+{
+    if (k <= 0)
+    {
+        return true;
+    }
+
+    if (m_graph->getDegree() <= 1 || m_graph->getMinDegree() < k || !isContinuous())
+    {
+        return false;
+    }
+
+    const Graph certificate(m_graph->getDegree(), MinimumCut::certificate(*m_graph, k), GraphRepresentation::SPARSE);
+    MinimumCut cut(certificate);
+
+    return cut.compute(nullptr, k) >= k;
+}
+
+int GraphSolver::bfCircumference() const noexcept
+{
+    if (m_graph->getDegree() < 3)
+    {
+        return 0;
+    }
+
+    if (hasHamiltonCircle())
+    {
+        return m_graph->getDegree();
+    }
+
+    // without Hamilton circle the longest one misses at least one node
+    return CircumferenceSearch(*m_graph).find(0, m_graph->getDegree() - 1);
+}
+
+/**
+ * Returns length of shortest circle found by breadth first search from given source, or zero
+ * Search stays within allowed nodes and ends once no circle shorter than given bound may appear
+ * @param graph
+ * @param source
+ * @param allowed
+ * @param bound
+ * @param distances per thread distances, minus one for unvisited nodes
+ * @param parents
+ * @param queue
+ * @return
+ */
+static int sparseGirthFrom(const Graph& graph, int source, const std::vector<char>& allowed, int bound,
+                           std::vector<int>& distances, std::vector<int>& parents, std::vector<int>& queue)
+{
+    int best = 0;
+
+    queue.assign(1, source);
+    distances[source] = 0;
+    parents[source] = -1;
+
+    for (int head = 0; head < static_cast<int>(queue.size()); head++)
+    {
+        const int node = queue[head];
+
+        // circle closed from deeper nodes has at least 2d + 1 edges
+        if (2 * distances[node] + 1 >= bound)
+        {
+            break;
+        }
+
+        for (int neighbour : graph.getNodeNeighbourRange(node))
+        {
+            if (!allowed[neighbour] || neighbour == parents[node])
+            {
+                continue;
+            }
+
+            if (distances[neighbour] == -1)
+            {
+                distances[neighbour] = distances[node] + 1;
+                parents[neighbour] = node;
+                queue.push_back(neighbour);
+                continue;
+            }
+
+            const int length = distances[node] + distances[neighbour] + 1;
+
+            if (length < bound)
+            {
+                bound = length;
+                best = length;
+            }
+        }
+    }
+
+    for (int node : queue)
+    {
+        distances[node] = -1;
+    }
+
+    return best;
+}
+
+/**
+ * Returns length of shortest circle found by layered bit parallel breadth first search from given source, or zero
+ * Layer with two adjacent nodes closes circle of odd length, node with two parents in previous layer of even length
+ * @param matrix
+ * @param source
+ * @param allowed
+ * @param bound
+ * @param visited
+ * @param frontier
+ * @param next
+ * @return
+ */
+static int denseGirthFrom(const BitMatrix& matrix, int source, const BitMatrix::Word* allowed, int bound,
+                          BitMatrix::Word* visited, BitMatrix::Word* frontier, BitMatrix::Word* next)
+{
+    const int words = matrix.words();
+
+    std::fill(frontier, frontier + words, 0);
+    frontier[source / BitMatrix::WORD_BITS] = BitMatrix::Word(1) << (source % BitMatrix::WORD_BITS);
+    std::copy(frontier, frontier + words, visited);
+
+    for (int depth = 0; 2 * depth + 1 < bound; depth++)
+    {
+        // odd circle within current layer
+        for (int w = 0; w < words && depth > 0; w++)
+        {
+            for (BitMatrix::Word rest = frontier[w]; rest; rest &= rest - 1)
+            {
+                const BitMatrix::Word* row = matrix.row(w * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(rest));
+
+                if (BitKernels::intersectionCount(row, frontier, words))
+                {
+                    return 2 * depth + 1;
+                }
+            }
+        }
+
+        if (2 * depth + 2 >= bound)
+        {
+            break;
+        }
+
+        std::fill(next, next + words, 0);
+
+        for (int w = 0; w < words; w++)
+        {
+            for (BitMatrix::Word rest = frontier[w]; rest; rest &= rest - 1)
+            {
+                BitKernels::unite(next, next, matrix.row(w * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(rest)), words);
+            }
+        }
+
+        BitKernels::intersect(next, next, allowed, words);
+        BitKernels::subtract(next, next, visited, words);
+
+        if (!BitKernels::popcount(next, words))
+        {
+            break;
+        }
+
+        // even circle through node of next layer reached twice
+        for (int w = 0; w < words; w++)
+        {
+            for (BitMatrix::Word rest = next[w]; rest; rest &= rest - 1)
+            {
+                const BitMatrix::Word* row = matrix.row(w * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(rest));
+
+                if (BitKernels::intersectionCount(row, frontier, words) > 1)
+                {
+                    return 2 * depth + 2;
+                }
+            }
+        }
+
+        BitKernels::unite(visited, visited, next, words);
+        std::copy(next, next + words, frontier);
+    }
+
+    return 0;
+}
+
+int GraphSolver::bfGirth() const noexcept
+{
+    const Graph& graph = *m_graph;
+    const int degree = graph.getDegree();
+
+    // nodes outside of 2-core lie on no circle and are peeled off first
+    std::vector<int> remaining(degree);
+    std::vector<char> core(degree, 1);
+    std::vector<int> leaves;
+
+    for (int i = 0; i < degree; i++)
+    {
+        remaining[i] = graph.getNodeDegree(i);
+
+        if (remaining[i] < 2)
+        {
+            core[i] = 0;
+            leaves.push_back(i);
+        }
+    }
+
+    while (!leaves.empty())
+    {
+        const int leaf = leaves.back();
+        leaves.pop_back();
+
+        for (int neighbour : graph.getNodeNeighbourRange(leaf))
+        {
+            if (core[neighbour] && --remaining[neighbour] < 2)
+            {
+                core[neighbour] = 0;
+                leaves.push_back(neighbour);
+            }
+        }
+    }
+
+    // every circle is found from its lowest node within nodes above it, sources are processed in parallel
+    ThreadPool& pool = ThreadPool::instance();
+    const int chunks = std::min(degree, 4 * pool.getThreadCount());
+    std::atomic<int> best(std::numeric_limits<int>::max());
+
+    const auto lower = [&best](int length)
+    {
+        int current = best;
+
+        while (length > 0 && length < current && !best.compare_exchange_weak(current, length))
+        {
+        }
+    };
+
+    pool.parallelFor(chunks, [&](int chunk)
+    {
+        if (graph.isSparse())
+        {
+            std::vector<char> allowed(core);
+            std::vector<int> distances(degree, -1);
+            std::vector<int> parents(degree);
+            std::vector<int> queue;
+
+            for (int i = 0; i < chunk; i++)
+            {
+                allowed[i] = 0;
+            }
+
+            for (int i = chunk; i < degree && best > 3; i += chunks)
+            {
+                int forward = 0;
+
+                for (int neighbour : graph.getNodeNeighbourRange(i))
+                {
+                    forward += allowed[neighbour] && neighbour > i;
+                }
+
+                if (core[i] && forward >= 2)
+                {
+                    lower(sparseGirthFrom(graph, i, allowed, best, distances, parents, queue));
+                }
+
+                for (int j = i; j < i + chunks && j < degree; j++)
+                {
+                    allowed[j] = 0;
+                }
+            }
+
+            return;
+        }
+
+        const BitMatrix& matrix = graph.getMatrix();
+        const int words = matrix.words();
+        std::vector<BitMatrix::Word> allowed(words, 0);
+        std::vector<BitMatrix::Word> visited(words);
+        std::vector<BitMatrix::Word> frontier(words);
+        std::vector<BitMatrix::Word> next(words);
+
+        for (int i = chunk + 1; i < degree; i++)
+        {
+            if (core[i])
+            {
+                allowed[i / BitMatrix::WORD_BITS] |= BitMatrix::Word(1) << (i % BitMatrix::WORD_BITS);
+            }
+        }
+
+        for (int i = chunk; i < degree && best > 3; i += chunks)
+        {
+            if (core[i] && BitKernels::intersectionCount(matrix.row(i), allowed.data(), words) >= 2)
+            {
+                lower(denseGirthFrom(matrix, i, allowed.data(), best, visited.data(), frontier.data(), next.data()));
+            }
+
+            for (int j = i + 1; j <= i + chunks && j < degree; j++)
+            {
+                allowed[j / BitMatrix::WORD_BITS] &= ~(BitMatrix::Word(1) << (j % BitMatrix::WORD_BITS));
+            }
+        }
+    });
+
+    return best == std::numeric_limits<int>::max() ? 0 : best.load();
+}
+
+int GraphSolver::bfChromaticNumber(std::vector<int>* coloring) const noexcept
+{
+    std::vector<int> colors;
+    const int result = ColoringSearch(*m_graph).find(colors);
+
+    if (coloring)
+    {
+        *coloring = std::move(colors);
+    }
+
+    return result;
+}
+
+using Word = BitMatrix::Word;
+
+/**
+ * Returns mask of bits above given bit within its word
+ * @param bit
+ * @return
+ */
+static constexpr Word bitsAbove(int bit) noexcept
+{
+    return bit % BitMatrix::WORD_BITS == BitMatrix::WORD_BITS - 1 ? 0 : ~Word(0) << (bit % BitMatrix::WORD_BITS + 1);
+}
+
+/**
+ * Returns whether given set of nodes contains three pairwise non adjacent nodes
+ * @param row accessor of adjacency rows
+ * @param set
+ * @param words
+ * @param candidates scratch row
+ * @return
+ */
+template <typename Rows>
+static bool hasIndependentTriple(const Rows& row, const Word* set, int words, Word* candidates) noexcept
+{
+    for (int w = 0; w < words; w++)
+    {
+        for (Word first = set[w]; first; first &= first - 1)
+        {
+            const int a = w * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(first);
+
+            // nodes of set above a, not adjacent to a
+            BitKernels::subtract(candidates + w, set + w, row(a) + w, words - w);
+            candidates[w] &= bitsAbove(a);
+
+            for (int v = w; v < words; v++)
+            {
+                for (Word second = candidates[v]; second; second &= second - 1)
+                {
+                    const int b = v * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(second);
+                    const Word* rowB = row(b);
+
+                    if (candidates[v] & ~rowB[v] & bitsAbove(b))
+                    {
+                        return true;
+                    }
+
+                    for (int u = v + 1; u < words; u++)
+                    {
+                        if (candidates[u] & ~rowB[u])
+                        {
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool GraphSolver::bfHasClaw() const noexcept
+{
+    if (m_graph->getDegree() < 4)
+    {
+        return false;
+    }
+
+    if (m_graph->getDegree() == 4)
+    {
+        return m_graph->isClaw();
+    }
+
+    if (m_graph->getDegree() <= SmallGraph<BitMatrix::WORD_BITS>::capacity())
+    {
+        return SmallGraph<BitMatrix::WORD_BITS>(*m_graph).hasClaw();
+    }
+
+    // claw is centre with three pairwise non adjacent neighbours, centres are checked in parallel
+    const Graph& graph = *m_graph;
+    ThreadPool& pool = ThreadPool::instance();
+    const int chunks = std::min(graph.getDegree(), 4 * pool.getThreadCount());
+    std::atomic<bool> found(false);
+
+    pool.parallelFor(chunks, [&](int chunk)
+    {
+        // sparse neighbourhoods are copied into local rows indexed by position in neighbourhood
+        const int words = graph.isSparse() ? BitMatrix::wordCount(graph.getMaxDegree()) : graph.getMatrix().words();
+        std::vector<Word> candidates(words);
+        std::vector<Word> local(graph.isSparse() ? std::size_t(graph.getMaxDegree()) * words : 0);
+        std::vector<Word> all(graph.isSparse() ? words : 0);
+        std::vector<int> position(graph.isSparse() ? graph.getDegree() : 0, -1);
+
+        for (int i = chunk; i < graph.getDegree() && !found.load(std::memory_order_relaxed); i += chunks)
+        {
+            if (graph.getNodeDegree(i) < 3)
+            {
+                continue;
+            }
+
+            if (!graph.isSparse())
+            {
+                const BitMatrix& matrix = graph.getMatrix();
+                const auto row = [&matrix](int index) { return matrix.row(index); };
+
+                if (hasIndependentTriple(row, matrix.row(i), words, candidates.data()))
+                {
+                    found = true;
+                }
+
+                continue;
+            }
+
+            const SparseMatrix& matrix = graph.getSparseMatrix();
+            const int degree = graph.getNodeDegree(i);
+            const int used = BitMatrix::wordCount(degree);
+
+            for (int j = 0; j < degree; j++)
+            {
+                position[matrix.rowBegin(i)[j]] = j;
+            }
+
+            std::fill(local.begin(), local.begin() + std::size_t(degree) * used, 0);
+            std::fill(all.begin(), all.begin() + used, ~Word(0));
+
+            if (degree % BitMatrix::WORD_BITS)
+            {
+                all[used - 1] = (Word(1) << (degree % BitMatrix::WORD_BITS)) - 1;
+            }
+
+            for (int j = 0; j < degree; j++)
+            {
+                const int* end = matrix.rowEnd(matrix.rowBegin(i)[j]);
+
+                for (const int* k = matrix.rowBegin(matrix.rowBegin(i)[j]); k != end; k++)
+                {
+                    if (position[*k] != -1)
+                    {
+                        local[std::size_t(j) * used + position[*k] / BitMatrix::WORD_BITS] |=
+                            Word(1) << (position[*k] % BitMatrix::WORD_BITS);
+                    }
+                }
+            }
+
+            for (int j = 0; j < degree; j++)
+            {
+                position[matrix.rowBegin(i)[j]] = -1;
+            }
+
+            const auto row = [&local, used](int index) { return local.data() + std::size_t(index) * used; };
+
+            if (hasIndependentTriple(row, all.data(), used, candidates.data()))
+            {
+                found = true;
+            }
+        }
+    });
+
+    return found;
+}
+
+bool GraphSolver::bfHamiltonRoute(std::vector<int>* route) const noexcept
+{
+    if (m_graph->getDegree() >= HEURISTIC_MIN_DEGREE && m_heuristicIterations > 0)
+    {
+        std::vector<int> result;
+
+        if (PosaHeuristic(*m_graph).find(true, result, m_heuristicIterations, m_heuristicTime) == SearchResult::FOUND)
+        {
+            if (route)
+            {
+                *route = std::move(result);
+            }
+
+            return true;
+        }
+    }
+
+    std::vector<int> result;
+    SearchResult found = SearchResult::INCONCLUSIVE;
+
+    // pruned search settles sparse and most dense graphs at once, subset table is filled only when it stalls
+    if (m_graph->getDegree() <= HamiltonDP::maxRouteDegree())
+    {
+        found = HamiltonSearch(*m_graph, true).find(result, SEARCH_STEP_LIMIT);
+
+        if (found == SearchResult::INCONCLUSIVE)
+        {
+            found = HamiltonDP(*m_graph).hasHamiltonRoute(&result);
+        }
+    }
+    else if (!route && m_graph->getDegree() <= SmallGraph<BitMatrix::WORD_BITS>::capacity())
+    {
+        return SmallGraph<BitMatrix::WORD_BITS>(*m_graph).hasHamiltonRoute();
+    }
+
+    if (found == SearchResult::INCONCLUSIVE)
+    {
+        found = HamiltonSearch(*m_graph, true).find(result);
+    }
+
+    if (route && found == SearchResult::FOUND)
+    {
+        *route = std::move(result);
+    }
+
+    return found == SearchResult::FOUND;
+}
+
+bool GraphSolver::bfHamiltonCircle(std::vector<int>* circle) const noexcept
+{
+    if (m_graph->getDegree() >= HEURISTIC_MIN_DEGREE && m_heuristicIterations > 0)
+    {
+        std::vector<int> result;
+
+        if (PosaHeuristic(*m_graph).find(false, result, m_heuristicIterations, m_heuristicTime) == SearchResult::FOUND)
+        {
+            if (circle)
+            {
+                *circle = std::move(result);
+            }
+
+            return true;
+        }
+    }
+
+    std::vector<int> result;
+    SearchResult found = SearchResult::INCONCLUSIVE;
+
+    // pruned search settles sparse and most dense graphs at once, subset table is filled only when it stalls
+    if (m_graph->getDegree() <= HamiltonDP::maxCircleDegree())
+    {
+        found = HamiltonSearch(*m_graph, false).find(result, SEARCH_STEP_LIMIT);
+
+        if (found == SearchResult::INCONCLUSIVE)
+        {
+            found = HamiltonDP(*m_graph).hasHamiltonCircle(&result);
+        }
+    }
+    else if (!circle && m_graph->getDegree() <= SmallGraph<BitMatrix::WORD_BITS>::capacity())
+    {
+        return SmallGraph<BitMatrix::WORD_BITS>(*m_graph).hasHamiltonCircle();
+    }
+
+    if (found == SearchResult::INCONCLUSIVE)
+    {
+        found = HamiltonSearch(*m_graph, false).find(result);
+    }
+
+    if (circle && found == SearchResult::FOUND)
+    {
+        *circle = std::move(result);
+    }
+
+    return found == SearchResult::FOUND;
 }
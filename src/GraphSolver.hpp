@@ -18,6 +18,13 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+#include "ScratchArena.hpp"
+
 // FORWARD DECLARATION
 class Graph;
 
@@ -26,7 +33,20 @@ class GraphSolver
 
 protected:
 
+    /**
+     * Smallest number of nodes for which heuristic runs before exact Hamilton check
+     */
+    static constexpr int HEURISTIC_MIN_DEGREE = 20;
+
+    /**
+     * Number of path extensions pruned search may take before small graph falls back to subset dynamic programming
+     */
+    static constexpr std::int64_t SEARCH_STEP_LIMIT = std::int64_t(1) << 16;
+
     Graph* m_graph;
+    mutable ScratchArena m_arena;
+    int m_heuristicIterations = 1000000;
+    std::chrono::milliseconds m_heuristicTime = std::chrono::milliseconds(100);
 
 public:
 
@@ -34,6 +54,34 @@ public:
         m_graph(graph)
     {}
 
+    virtual ~GraphSolver() = default;
+
+    /**
+     * Discards all cached results, called after graph is modified
+     */
+    virtual void reset() noexcept
+    {}
+
+    /**
+     * Returns arena for temporary objects of current query
+     * @return
+     */
+    ScratchArena& getArena() const noexcept
+    {
+        return m_arena;
+    }
+
+    /**
+     * Sets budget of heuristic run before exact Hamilton checks, zero disables heuristic
+     * @param iterations
+     * @param time
+     */
+    void setHeuristicBudget(int iterations, std::chrono::milliseconds time) noexcept
+    {
+        m_heuristicIterations = iterations;
+        m_heuristicTime = time;
+    }
+
 public:
 
     /**
@@ -74,6 +122,33 @@ public:
      */
     virtual bool isKEdgeContinuous(int k) const noexcept;
 
+    /**
+     * Returns number of connected components
+     * @return
+     */
+    virtual int getComponentCount() const noexcept;
+
+    /**
+     * Returns label of connected component of every node
+     * Components are numbered from zero in order of their lowest node
+     * @return
+     */
+    virtual std::vector<int> getComponents() const noexcept;
+
+    /**
+     * Returns biconnected blocks, each as ascending list of its nodes
+     * Bridges form blocks of two nodes and isolated nodes blocks of one node
+     * @return
+     */
+    virtual std::vector<std::vector<int>> getBlocks() const noexcept;
+
+    /**
+     * Returns ascending list of nodes on one side of minimum edge cut
+     * Edges between listed and remaining nodes form the cut, empty for graphs with less than two nodes
+     * @return
+     */
+    virtual std::vector<int> getMinimumCut() const noexcept;
+
 public:
 
     /*
@@ -128,6 +203,18 @@ public:
      */
     virtual bool hasHamiltonCircle() const noexcept;
 
+    /**
+     * Returns order of nodes of some Hamilton route, empty if there is none
+     * @return
+     */
+    virtual std::vector<int> getHamiltonRoute() const noexcept;
+
+    /**
+     * Returns order of nodes of some Hamilton circle, empty if there is none
+     * @return
+     */
+    virtual std::vector<int> getHamiltonCircle() const noexcept;
+
 public:
 
     /*
@@ -140,6 +227,12 @@ public:
      */
     virtual int getChromaticNumber() const noexcept;
 
+    /**
+     * Returns color of every node in coloring by chromatic number of colors, numbered from zero
+     * @return
+     */
+    virtual std::vector<int> getColoring() const noexcept;
+
 protected:
 
     /**
@@ -163,13 +256,6 @@ protected:
      */
     bool ore1960() const noexcept;
 
-    /**
-     * Póza (1963)
-     * Existence of Hamilton circle
-     * @return
-     */
-    bool poza1963() const noexcept;
-
     /**
      * Chvátal (1972)
      * Existence of Hamilton circle
@@ -191,6 +277,14 @@ protected:
      */
     bool oberlySummer1979() const noexcept;
 
+    /**
+     * Structural obstructions found by single depth first pass in O(n + m)
+     * Disconnected graph, low degrees, cut vertices and unbalanced bipartite graph
+     * @param route check obstructions of Hamilton route instead of circle
+     * @return true when graph provably has no Hamilton circle (route)
+     */
+    bool hamiltonObstruction(bool route) const noexcept;
+
 protected:
 
     /*
@@ -203,6 +297,37 @@ protected:
      */
     bool bfContinuity() const noexcept;
 
+    /**
+     * Evaluates property on subgraphs induced by connected components, components are processed in parallel
+     * @param property receives component and its label
+     * @param cyclicOnly skip trees, their value is zero
+     * @return value of every component in order of component labels
+     */
+    std::vector<int> evaluateComponents(const std::function<int(const Graph&, int)>& property, bool cyclicOnly) const;
+
+    /**
+     * Evaluates property on subgraphs induced by given sets of nodes in parallel
+     * @param nodeSets
+     * @param property receives subgraph and index of its set
+     * @return value of every subgraph in order of given sets
+     */
+    std::vector<int> evaluateSubgraphs(const std::vector<std::vector<int>>& nodeSets,
+                                       const std::function<int(const Graph&, int)>& property) const;
+
+    /**
+     * Finds biconnected blocks by iterative Tarjan depth first search
+     * @param blocks receives nodes of every block
+     */
+    void bfBlocks(std::vector<std::vector<int>>& blocks) const noexcept;
+
+    /**
+     * Labels connected components by iterative breadth first search
+     * Dense graphs expand whole frontier at once by word operations over rows
+     * @param labels receives label of component of every node
+     * @return number of components
+     */
+    int bfComponents(std::vector<int>& labels) const noexcept;
+
     /**
      * Bruce force check for local continuity
      * @return
@@ -210,29 +335,64 @@ protected:
     bool bfLocalContinuity() const noexcept;
 
     /**
-     * Bruce force calculation of degree of node continuity
+     * Calculation of degree of node continuity by unit flows on sparse certificate
+     * @param bound known upper bound, such as edge continuity
      * @return
      */
-    int bfNodeContinuity() const noexcept;
+    int bfNodeContinuity(int bound = std::numeric_limits<int>::max()) const noexcept;
 
     /**
-     * Bruce force calculation of degree of edge continuity
+     * Check whether node continuity reaches given bound
+     * Flows on sparse certificate of graph stop after k augmenting paths
+     * @param k
      * @return
      */
-    int bfEdgeContinuity() const noexcept;
+    bool bfKNodeContinuity(int k) const noexcept;
 
     /**
-     * Bruce force calculation of circumeference
+     * Calculation of node continuity capped at k by Even's checks on k certificate
+     * First k scanned nodes are separated pairwise, every later node needs fan of k paths to earlier ones
+     * Search stops once some check drops to given lower value, which is then returned
+     * @param k
+     * @param lower
+     * @return
+     */
+    int bfBoundedNodeContinuity(int k, int lower) const noexcept;
+
+    /**
+     * Calculation of degree of edge continuity by maximum adjacency orderings
+     * @param side if given, receives nodes on one side of minimum edge cut
+     * @return
+     */
+    int bfEdgeContinuity(std::vector<int>* side = nullptr) const noexcept;
+
+    /**
+     * Check whether edge continuity reaches given bound
+     * Cut search on sparse certificate of graph contracts every edge shown to carry k disjoint paths
+     * @param k
+     * @return
+     */
+    bool bfKEdgeContinuity(int k) const noexcept;
+
+    /**
+     * Calculation of circumference, Hamilton circle is tried first and branch and bound search follows
      * @return
      */
     int bfCircumference() const noexcept;
 
     /**
-     * Bruce force calculation of girth
+     * Calculation of girth by breadth first search from every node of 2-core, zero for acyclic graph
      * @return
      */
     int bfGirth() const noexcept;
 
+    /**
+     * Calculation of chromatic number by DSATUR branch and bound
+     * @param coloring if given, receives color of every node
+     * @return
+     */
+    int bfChromaticNumber(std::vector<int>* coloring = nullptr) const noexcept;
+
     /**
      * Brute force check for claw subgraph
      * @return
@@ -240,14 +400,16 @@ protected:
     bool bfHasClaw() const noexcept;
 
     /**
-     * Brute force check for Hamilton circle
+     * Brute force check for Hamilton route
+     * @param route if given, receives order of nodes of found route
      * @return
      */
-    bool bfHamiltonRoute() const noexcept;
+    bool bfHamiltonRoute(std::vector<int>* route = nullptr) const noexcept;
 
     /**
      * Brute force check for Hamilton circle
+     * @param circle if given, receives order of nodes of found circle
      * @return
      */
-    bool bfHamiltonCircle() const noexcept;
+    bool bfHamiltonCircle(std::vector<int>* circle = nullptr) const noexcept;
 };
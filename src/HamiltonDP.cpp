@@ -0,0 +1,221 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <new>
+#include "HamiltonDP.hpp"
+#include "ThreadPool.hpp"
+
+using Mask = HamiltonDP::Mask;
+
+/**
+ * Binomial coefficients for ranking subsets of up to 32 elements
+ */
+static const std::array<std::array<std::uint64_t, 33>, 33>& binomials() noexcept
+{
+    static const auto table = []()
+    {
+        std::array<std::array<std::uint64_t, 33>, 33> result {};
+
+        for (int n = 0; n <= 32; n++)
+        {
+            result[n][0] = 1;
+
+            for (int k = 1; k <= n; k++)
+            {
+                result[n][k] = result[n - 1][k - 1] + (k <= n - 1 ? result[n - 1][k] : 0);
+            }
+        }
+
+        return result;
+    }();
+
+    return table;
+}
+
+/**
+ * Returns subset of given size at given position in increasing numeric order
+ * @param rank
+ * @param size
+ * @return
+ */
+static std::uint64_t unrankSubset(std::uint64_t rank, int size) noexcept
+{
+    std::uint64_t subset = 0;
+
+    for (int k = size; k > 0; k--)
+    {
+        int element = k - 1;
+
+        while (binomials()[element + 1][k] <= rank)
+        {
+            element++;
+        }
+
+        subset |= std::uint64_t(1) << element;
+        rank -= binomials()[element][k];
+    }
+
+    return subset;
+}
+
+/**
+ * Returns next larger subset of the same size (Gosper's hack)
+ * @param subset
+ * @return
+ */
+static std::uint64_t nextSubset(std::uint64_t subset) noexcept
+{
+    const std::uint64_t lowest = subset & (~subset + 1);
+    const std::uint64_t ripple = subset + lowest;
+
+    return (((ripple ^ subset) >> 2) / lowest) | ripple;
+}
+
+HamiltonDP::HamiltonDP(const Graph& graph) :
+    m_neighbours(graph.getDegree(), 0),
+    m_degree(graph.getDegree())
+{
+    for (int i = 0; i < m_degree; i++)
+    {
+        for (int neighbour : graph.getNodeNeighbourRange(i))
+        {
+            m_neighbours[i] |= Mask(1) << neighbour;
+        }
+    }
+}
+
+SearchResult HamiltonDP::hasHamiltonRoute(std::vector<int>* route) const
+{
+    if (m_degree <= 1)
+    {
+        if (route && m_degree == 1)
+        {
+            route->assign(1, 0);
+        }
+
+        return m_degree == 1 ? SearchResult::FOUND : SearchResult::ABSENT;
+    }
+
+    const Mask all = m_degree == 32 ? ~Mask(0) : (Mask(1) << m_degree) - 1;
+    std::unique_ptr<Mask[]> table(new (std::nothrow) Mask[std::size_t(1) << m_degree]);
+
+    if (!table)
+    {
+        return SearchResult::INCONCLUSIVE;
+    }
+
+    fillTable(table.get(), m_degree, all);
+
+    if (route && table[all])
+    {
+        tracePath(table.get(), all, all, *route);
+    }
+
+    return table[all] ? SearchResult::FOUND : SearchResult::ABSENT;
+}
+
+SearchResult HamiltonDP::hasHamiltonCircle(std::vector<int>* circle) const
+{
+    if (m_degree < 3)
+    {
+        return SearchResult::ABSENT;
+    }
+
+    // circle passes through last node, paths start in its neighbours and cover the rest
+    const int bits = m_degree - 1;
+    const Mask all = (Mask(1) << bits) - 1;
+    const Mask closing = m_neighbours[bits] & all;
+    std::unique_ptr<Mask[]> table(new (std::nothrow) Mask[std::size_t(1) << bits]);
+
+    if (!table)
+    {
+        return SearchResult::INCONCLUSIVE;
+    }
+
+    fillTable(table.get(), bits, closing);
+
+    if (circle && (table[all] & closing))
+    {
+        tracePath(table.get(), all, closing, *circle);
+        circle->push_back(bits);
+    }
+
+    return (table[all] & closing) ? SearchResult::FOUND : SearchResult::ABSENT;
+}
+
+void HamiltonDP::fillTable(Mask* table, int bits, Mask starts) const
+{
+    for (int i = 0; i < bits; i++)
+    {
+        table[Mask(1) << i] = starts & (Mask(1) << i);
+    }
+
+    ThreadPool& pool = ThreadPool::instance();
+
+    for (int size = 2; size <= bits; size++)
+    {
+        const std::uint64_t count = binomials()[bits][size];
+        const std::uint64_t chunkSize = std::max<std::uint64_t>(4096, count / (8 * pool.getThreadCount()) + 1);
+        const int chunks = static_cast<int>((count + chunkSize - 1) / chunkSize);
+
+        pool.parallelFor(chunks, [&](int chunk)
+        {
+            const std::uint64_t begin = chunk * chunkSize;
+            const std::uint64_t end = std::min(count, begin + chunkSize);
+            std::uint64_t subset = unrankSubset(begin, size);
+
+            for (std::uint64_t i = begin; i < end; i++, subset = nextSubset(subset))
+            {
+                const Mask mask = static_cast<Mask>(subset);
+                Mask ends = 0;
+
+                // node can end the path if path over the rest ends in its neighbour
+                for (Mask rest = mask; rest; rest &= rest - 1)
+                {
+                    const int node = BitMatrix::countTrailingZeros(rest);
+
+                    if (table[mask ^ (Mask(1) << node)] & m_neighbours[node])
+                    {
+                        ends |= Mask(1) << node;
+                    }
+                }
+
+                table[mask] = ends;
+            }
+        });
+    }
+}
+
+void HamiltonDP::tracePath(const Mask* table, Mask subset, Mask ends, std::vector<int>& path) const
+{
+    path.clear();
+
+    while (subset)
+    {
+        const int node = BitMatrix::countTrailingZeros(table[subset] & ends);
+
+        path.push_back(node);
+        subset ^= Mask(1) << node;
+        ends = m_neighbours[node];
+    }
+
+    std::reverse(path.begin(), path.end());
+}
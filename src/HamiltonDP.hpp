@@ -0,0 +1,117 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Graph.hpp"
+#include "SearchResult.hpp"
+
+/**
+ * Exact Hamilton route and circle check by dynamic programming over node subsets (Held-Karp)
+ * Each subset stores bitset of nodes in which path covering exactly that subset can end
+ * Subsets of equal size are independent and processed in parallel
+ */
+class HamiltonDP
+{
+
+public:
+
+    using Mask = std::uint32_t;
+
+    /**
+     * Upper bound of memory used by subset table, table of 2^24 subsets
+     */
+    static constexpr std::size_t MEMORY_LIMIT = std::size_t(64) << 20;
+
+protected:
+
+    std::vector<Mask> m_neighbours;
+    int m_degree;
+
+public:
+
+    /**
+     * Constructor by graph with at most 32 nodes
+     * @param graph
+     */
+    explicit HamiltonDP(const Graph& graph);
+
+public:
+
+    /**
+     * Returns largest number of nodes for which route check fits into memory limit
+     * @return
+     */
+    static constexpr int maxRouteDegree() noexcept
+    {
+        int bits = 0;
+
+        while (bits < 31 && (std::size_t(2) << bits) * sizeof(Mask) <= MEMORY_LIMIT)
+        {
+            bits++;
+        }
+
+        return bits;
+    }
+
+    /**
+     * Returns largest number of nodes for which circle check fits into memory limit
+     * Circle check fixes one node outside of subsets
+     * @return
+     */
+    static constexpr int maxCircleDegree() noexcept
+    {
+        return maxRouteDegree() + 1;
+    }
+
+    /**
+     * Returns whether graph contains Hamilton route, inconclusive when subset table cannot be allocated
+     * @param route if given, receives order of nodes of found route
+     * @return
+     */
+    SearchResult hasHamiltonRoute(std::vector<int>* route = nullptr) const;
+
+    /**
+     * Returns whether graph contains Hamilton circle, inconclusive when subset table cannot be allocated
+     * @param circle if given, receives order of nodes of found circle
+     * @return
+     */
+    SearchResult hasHamiltonCircle(std::vector<int>* circle = nullptr) const;
+
+protected:
+
+    /**
+     * Fills table for all subsets of first given number of nodes
+     * @param table
+     * @param bits
+     * @param starts nodes which may start path
+     */
+    void fillTable(Mask* table, int bits, Mask starts) const;
+
+    /**
+     * Walks filled table back from given set of allowed ends and stores path covering given subset
+     * @param table
+     * @param subset
+     * @param ends
+     * @param path
+     */
+    void tracePath(const Mask* table, Mask subset, Mask ends, std::vector<int>& path) const;
+};
@@ -0,0 +1,375 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#include <algorithm>
+#include "HamiltonSearch.hpp"
+
+HamiltonSearch::HamiltonSearch(const Graph& graph, bool route) :
+    m_degree(graph.getDegree() + (route ? 1 : 0)),
+    m_start(0),
+    m_route(route),
+    m_offsets(m_degree + 1, 0)
+{
+    const int virtualNode = graph.getDegree();
+
+    for (int i = 0; i < graph.getDegree(); i++)
+    {
+        m_offsets[i + 1] = m_offsets[i] + graph.getNodeDegree(i) + (route ? 1 : 0);
+    }
+
+    if (route)
+    {
+        m_offsets[virtualNode + 1] = m_offsets[virtualNode] + graph.getDegree();
+    }
+
+    m_targets.reserve(m_offsets[m_degree]);
+
+    for (int i = 0; i < graph.getDegree(); i++)
+    {
+        for (int neighbour : graph.getNodeNeighbourRange(i))
+        {
+            m_targets.push_back(neighbour);
+        }
+
+        if (route)
+        {
+            m_targets.push_back(virtualNode);
+        }
+    }
+
+    if (route)
+    {
+        for (int i = 0; i < graph.getDegree(); i++)
+        {
+            m_targets.push_back(i);
+        }
+
+        m_start = virtualNode;
+    }
+    else
+    {
+        // the fewer neighbours the start has, the fewer branches at the end of search
+        for (int i = 0; i < m_degree; i++)
+        {
+            if (graph.getNodeDegree(i) < graph.getNodeDegree(m_start))
+            {
+                m_start = i;
+            }
+        }
+    }
+}
+
+SearchResult HamiltonSearch::find(std::vector<int>& result, std::int64_t limit)
+{
+    result.clear();
+
+    if (m_route && m_degree <= 2)
+    {
+        if (m_degree == 2)
+        {
+            result.push_back(0);
+        }
+
+        return m_degree == 2 ? SearchResult::FOUND : SearchResult::ABSENT;
+    }
+
+    if (m_degree < 3)
+    {
+        return SearchResult::ABSENT;
+    }
+
+    m_freeDegrees.resize(m_degree);
+    m_visited.assign(m_degree, 0);
+    m_marks.assign(m_degree, 0);
+    m_path.clear();
+
+    for (int i = 0; i < m_degree; i++)
+    {
+        m_freeDegrees[i] = m_offsets[i + 1] - m_offsets[i];
+
+        if (m_freeDegrees[i] < 2)
+        {
+            return SearchResult::ABSENT;
+        }
+    }
+
+    if (!connected())
+    {
+        return SearchResult::ABSENT;
+    }
+
+    m_visited[m_start] = 1;
+    m_path.push_back(m_start);
+
+    // candidates of all open path positions are kept in single stack
+    struct Frame
+    {
+        int base;
+        int next;
+    };
+
+    std::vector<Frame> frames;
+    std::vector<int> stack;
+    std::vector<int> candidates;
+
+    if (!collectCandidates(candidates))
+    {
+        return SearchResult::ABSENT;
+    }
+
+    frames.push_back({0, 0});
+    stack.assign(candidates.begin(), candidates.end());
+
+    while (!frames.empty())
+    {
+        Frame& frame = frames.back();
+
+        if (frame.next == static_cast<int>(stack.size()))
+        {
+            stack.resize(frame.base);
+            frames.pop_back();
+
+            if (!frames.empty())
+            {
+                retreat();
+            }
+
+            continue;
+        }
+
+        if (limit-- == 0)
+        {
+            return SearchResult::INCONCLUSIVE;
+        }
+
+        const int node = stack[frame.next++];
+
+        if (!advance(node))
+        {
+            retreat();
+            continue;
+        }
+
+        if (static_cast<int>(m_path.size()) == m_degree)
+        {
+            if (hasEdge(node, m_start))
+            {
+                result.assign(m_path.begin() + (m_route ? 1 : 0), m_path.end());
+                return SearchResult::FOUND;
+            }
+
+            retreat();
+            continue;
+        }
+
+        if (!collectCandidates(candidates))
+        {
+            retreat();
+            continue;
+        }
+
+        const int base = static_cast<int>(stack.size());
+        stack.insert(stack.end(), candidates.begin(), candidates.end());
+        frames.push_back({base, base});
+    }
+
+    return SearchResult::ABSENT;
+}
+
+bool HamiltonSearch::advance(int node) noexcept
+{
+    const int end = m_path.back();
+
+    // previous end becomes inner node of path and stops being free
+    if (end != m_start)
+    {
+        for (int i = m_offsets[end]; i < m_offsets[end + 1]; i++)
+        {
+            if (!m_visited[m_targets[i]])
+            {
+                m_freeDegrees[m_targets[i]]--;
+            }
+        }
+    }
+
+    m_visited[node] = 1;
+    m_path.push_back(node);
+
+    if (end != m_start)
+    {
+        for (int i = m_offsets[end]; i < m_offsets[end + 1]; i++)
+        {
+            if (!m_visited[m_targets[i]] && m_freeDegrees[m_targets[i]] < 2)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void HamiltonSearch::retreat() noexcept
+{
+    m_visited[m_path.back()] = 0;
+    m_path.pop_back();
+
+    const int end = m_path.back();
+
+    if (end != m_start)
+    {
+        for (int i = m_offsets[end]; i < m_offsets[end + 1]; i++)
+        {
+            if (!m_visited[m_targets[i]])
+            {
+                m_freeDegrees[m_targets[i]]++;
+            }
+        }
+    }
+}
+
+bool HamiltonSearch::collectCandidates(std::vector<int>& candidates) const
+{
+    const int end = m_path.back();
+    int forced = -1;
+    int startForced = 0;
+
+    candidates.clear();
+
+    for (int i = m_offsets[end]; i < m_offsets[end + 1]; i++)
+    {
+        const int neighbour = m_targets[i];
+
+        if (m_visited[neighbour])
+        {
+            continue;
+        }
+
+        // neighbour would lose second free neighbour as soon as path moves elsewhere
+        if (end != m_start && m_freeDegrees[neighbour] == 2)
+        {
+            if (forced != -1)
+            {
+                return false;
+            }
+
+            forced = neighbour;
+        }
+
+        // neighbour of start with two neighbours is either first or last node, reversal makes it first
+        if (end == m_start && m_freeDegrees[neighbour] == 2)
+        {
+            if (++startForced > 2)
+            {
+                return false;
+            }
+
+            forced = neighbour;
+        }
+
+        candidates.push_back(neighbour);
+    }
+
+    if (forced != -1)
+    {
+        candidates.assign(1, forced);
+        return true;
+    }
+
+    if (candidates.size() > 1)
+    {
+        std::sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+            return m_freeDegrees[a] < m_freeDegrees[b];
+        });
+
+        return remainderConnected();
+    }
+
+    return !candidates.empty();
+}
+
+bool HamiltonSearch::hasEdge(int index1, int index2) const noexcept
+{
+    return std::find(m_targets.begin() + m_offsets[index1], m_targets.begin() + m_offsets[index1 + 1], index2) !=
+        m_targets.begin() + m_offsets[index1 + 1];
+}
+
+bool HamiltonSearch::remainderConnected() const
+{
+    const int remaining = m_degree - static_cast<int>(m_path.size());
+    int reached = 0;
+    bool closing = false;
+
+    m_stamp++;
+    m_queue.clear();
+    m_queue.push_back(m_path.back());
+    m_marks[m_path.back()] = m_stamp;
+
+    for (int head = 0; head < static_cast<int>(m_queue.size()); head++)
+    {
+        const int node = m_queue[head];
+
+        for (int i = m_offsets[node]; i < m_offsets[node + 1]; i++)
+        {
+            const int neighbour = m_targets[i];
+
+            if (neighbour == m_start && node != m_path.back())
+            {
+                closing = true;
+            }
+
+            if (!m_visited[neighbour] && m_marks[neighbour] != m_stamp)
+            {
+                m_marks[neighbour] = m_stamp;
+                m_queue.push_back(neighbour);
+                reached++;
+            }
+        }
+    }
+
+    return reached == remaining && closing;
+}
+
+bool HamiltonSearch::connected() const
+{
+    int reached = 1;
+
+    // route node is last, so the first node always belongs to searched graph
+    m_stamp++;
+    m_queue.assign(1, 0);
+    m_marks[0] = m_stamp;
+
+    for (int head = 0; head < static_cast<int>(m_queue.size()); head++)
+    {
+        const int node = m_queue[head];
+
+        for (int i = m_offsets[node]; i < m_offsets[node + 1]; i++)
+        {
+            const int neighbour = m_targets[i];
+
+            if ((!m_route || neighbour != m_start) && m_marks[neighbour] != m_stamp)
+            {
+                m_marks[neighbour] = m_stamp;
+                m_queue.push_back(neighbour);
+                reached++;
+            }
+        }
+    }
+
+    return reached == (m_route ? m_degree - 1 : m_degree);
+}
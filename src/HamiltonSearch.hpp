@@ -0,0 +1,114 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Graph.hpp"
+#include "SearchResult.hpp"
+
+/**
+ * Backtracking search for Hamilton circle or route returning the circle or route found
+ * Route search looks for circle in graph extended by node adjacent to all other nodes
+ * Pruning:
+ *  - every node outside of path needs two free neighbours (outside of path or path end)
+ *  - neighbour of path end with only two free neighbours has to be visited next
+ *  - neighbour of path start with only two neighbours is visited first, circle can be reversed
+ *  - nodes outside of path have to stay reachable from path end and path start
+ */
+class HamiltonSearch
+{
+
+protected:
+
+    int m_degree;
+    int m_start;
+    bool m_route;
+    std::vector<int> m_offsets;
+    std::vector<int> m_targets;
+
+    std::vector<int> m_freeDegrees;
+    std::vector<char> m_visited;
+    std::vector<int> m_path;
+
+    mutable std::vector<int> m_marks;
+    mutable std::vector<int> m_queue;
+    mutable int m_stamp = 0;
+
+public:
+
+    /**
+     * Constructor by graph
+     * @param graph
+     * @param route search for route instead of circle
+     */
+    HamiltonSearch(const Graph& graph, bool route);
+
+public:
+
+    /**
+     * Runs search and stores found circle or route into result
+     * @param result
+     * @param limit maximal number of path extensions, search is inconclusive when exceeded
+     * @return
+     */
+    SearchResult find(std::vector<int>& result, std::int64_t limit = std::numeric_limits<std::int64_t>::max());
+
+protected:
+
+    /**
+     * Moves path end to given node, returns false when move leaves some node without two free neighbours
+     * @param node
+     * @return
+     */
+    bool advance(int node) noexcept;
+
+    /**
+     * Reverts last move of path end
+     */
+    void retreat() noexcept;
+
+    /**
+     * Stores candidates for next node of path into given vector, most constrained first
+     * @param candidates
+     * @return false when path cannot be completed
+     */
+    bool collectCandidates(std::vector<int>& candidates) const;
+
+    /**
+     * Returns whether nodes at given indices are adjacent
+     * @param index1
+     * @param index2
+     * @return
+     */
+    bool hasEdge(int index1, int index2) const noexcept;
+
+    /**
+     * Returns whether all nodes outside of path are reachable from path end and connected to path start
+     * @return
+     */
+    bool remainderConnected() const;
+
+    /**
+     * Returns whether nodes of searched graph are connected, ignoring added route node
+     * @return
+     */
+    bool connected() const;
+};
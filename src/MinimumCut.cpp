@@ -0,0 +1,341 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+
+#include <algorithm>
+#include "MinimumCut.hpp"
+
+/**
+ * Returns representative of union find class of given node, compressing the path
+ * @param parents
+ * @param node
+ * @return
+ */
+static int findRoot(std::vector<int>& parents, int node) noexcept
+{
+    while (parents[node] != node)
+    {
+        parents[node] = parents[parents[node]];
+        node = parents[node];
+    }
+
+    return node;
+}
+
+MinimumCut::MinimumCut(const Graph& graph) :
+    m_degree(graph.getDegree()),
+    m_owners(graph.getDegree())
+{
+    m_graph.offsets.assign(m_degree + 1, 0);
+
+    for (int i = 0; i < m_degree; i++)
+    {
+        m_graph.offsets[i + 1] = m_graph.offsets[i] + graph.getNodeDegree(i);
+        m_owners[i] = i;
+    }
+
+    m_graph.targets.reserve(m_graph.offsets.back());
+
+    for (int i = 0; i < m_degree; i++)
+    {
+        for (int neighbour : graph.getNodeNeighbourRange(i))
+        {
+            m_graph.targets.push_back(neighbour);
+        }
+    }
+
+    m_graph.weights.assign(m_graph.targets.size(), 1);
+}
+
+int MinimumCut::compute(std::vector<int>* side, int limit)
+{
+    if (m_degree < 2)
+    {
+        if (side)
+        {
+            side->clear();
+        }
+
+        return 0;
+    }
+
+    // lightest node alone is the first candidate
+    int lightest = 0;
+
+    for (int i = 0; i < m_degree; i++)
+    {
+        if (m_graph.offsets[i + 1] - m_graph.offsets[i] < m_graph.offsets[lightest + 1] - m_graph.offsets[lightest])
+        {
+            lightest = i;
+        }
+    }
+
+    int bound = std::min(limit, m_graph.offsets[lightest + 1] - m_graph.offsets[lightest]);
+    std::vector<int> parents;
+
+    if (side)
+    {
+        side->assign(1, lightest);
+    }
+
+    while (bound > 0 && m_graph.offsets.size() > 2)
+    {
+        const int nodes = static_cast<int>(m_graph.offsets.size()) - 1;
+        const int previous = bound;
+
+        parents.resize(nodes);
+
+        for (int i = 0; i < nodes; i++)
+        {
+            parents[i] = i;
+        }
+
+        const int last = phase(bound, parents);
+
+        // original nodes owned by last contracted node form one side of the improved cut
+        if (side && bound < previous)
+        {
+            side->clear();
+
+            for (int i = 0; i < m_degree; i++)
+            {
+                if (m_owners[i] == last)
+                {
+                    side->push_back(i);
+                }
+            }
+        }
+
+        contract(parents);
+    }
+
+    return bound;
+}
+
+std::vector<std::pair<int, int>> MinimumCut::certificate(const Graph& graph, int k, std::vector<int>* order)
+{
+    const MinimumCut cut(graph);
+    std::vector<std::pair<int, int>> forests;
+    std::vector<int> parents(graph.getDegree());
+    int bound = k;
+
+    for (int i = 0; i < graph.getDegree(); i++)
+    {
+        parents[i] = i;
+    }
+
+    if (order)
+    {
+        order->clear();
+    }
+
+    if (graph.getDegree() > 1)
+    {
+        cut.phase(bound, parents, &forests, order);
+    }
+    else if (order && graph.getDegree() == 1)
+    {
+        order->push_back(0);
+    }
+
+    return forests;
+}
+
+int MinimumCut::phase(int& bound, std::vector<int>& parents, std::vector<std::pair<int, int>>* forests,
+                      std::vector<int>* order) const
+{
+    const int nodes = static_cast<int>(m_graph.offsets.size()) - 1;
+    std::vector<int> keys(nodes, 0);
+    std::vector<char> added(nodes, 0);
+    std::vector<int> next(nodes, -1);
+    std::vector<int> previous(nodes, -1);
+    std::vector<int> heads(1, -1);
+    int top = 0;
+    int last = -1;
+    int beforeLast = -1;
+
+    // bucket queue of nodes by key, node moves up by weight of every edge to already ordered nodes
+    const auto unlink = [&](int node)
+    {
+        if (previous[node] != -1)
+        {
+            next[previous[node]] = next[node];
+        }
+        else
+        {
+            heads[keys[node]] = next[node];
+        }
+
+        if (next[node] != -1)
+        {
+            previous[next[node]] = previous[node];
+        }
+    };
+
+    const auto link = [&](int node)
+    {
+        if (keys[node] >= static_cast<int>(heads.size()))
+        {
+            heads.resize(keys[node] + 1, -1);
+        }
+
+        previous[node] = -1;
+        next[node] = heads[keys[node]];
+
+        if (next[node] != -1)
+        {
+            previous[next[node]] = node;
+        }
+
+        heads[keys[node]] = node;
+        top = std::max(top, keys[node]);
+    };
+
+    for (int i = nodes - 1; i >= 0; i--)
+    {
+        link(i);
+    }
+
+    for (int step = 0; step < nodes; step++)
+    {
+        while (heads[top] == -1)
+        {
+            top--;
+        }
+
+        const int node = heads[top];
+
+        unlink(node);
+        added[node] = 1;
+        beforeLast = last;
+        last = node;
+
+        if (order)
+        {
+            order->push_back(node);
+        }
+
+        for (int i = m_graph.offsets[node]; i < m_graph.offsets[node + 1]; i++)
+        {
+            const int neighbour = m_graph.targets[i];
+
+            if (added[neighbour])
+            {
+                continue;
+            }
+
+            // edge joins forest numbered by key of its later endpoint
+            if (forests && keys[neighbour] < bound)
+            {
+                forests->emplace_back(node, neighbour);
+            }
+
+            unlink(neighbour);
+            keys[neighbour] += m_graph.weights[i];
+            link(neighbour);
+
+            // Nagamochi-Ibaraki: endpoints are connected at least as strongly as key of later one
+            if (keys[neighbour] >= bound)
+            {
+                parents[findRoot(parents, neighbour)] = findRoot(parents, node);
+            }
+        }
+    }
+
+    // Stoer-Wagner: key of last node is the minimum cut between last two nodes
+    if (keys[last] < bound)
+    {
+        bound = keys[last];
+    }
+
+    parents[findRoot(parents, last)] = findRoot(parents, beforeLast);
+
+    return last;
+}
+
+void MinimumCut::contract(std::vector<int>& parents)
+{
+    const int nodes = static_cast<int>(m_graph.offsets.size()) - 1;
+    std::vector<int> labels(nodes, -1);
+    int count = 0;
+
+    for (int i = 0; i < nodes; i++)
+    {
+        const int root = findRoot(parents, i);
+
+        if (labels[root] == -1)
+        {
+            labels[root] = count++;
+        }
+
+        labels[i] = labels[root];
+    }
+
+    for (int& owner : m_owners)
+    {
+        owner = labels[owner];
+    }
+
+    // edges of every new node are gathered by old nodes, parallel edges are merged through position marks
+    std::vector<std::vector<int>> members(count);
+    std::vector<int> positions(count, -1);
+    WeightedGraph contracted;
+
+    for (int i = 0; i < nodes; i++)
+    {
+        members[labels[i]].push_back(i);
+    }
+
+    contracted.offsets.assign(count + 1, 0);
+
+    for (int node = 0; node < count; node++)
+    {
+        const int begin = static_cast<int>(contracted.targets.size());
+
+        for (int member : members[node])
+        {
+            for (int i = m_graph.offsets[member]; i < m_graph.offsets[member + 1]; i++)
+            {
+                const int target = labels[m_graph.targets[i]];
+
+                if (target == node)
+                {
+                    continue;
+                }
+
+                if (positions[target] == -1)
+                {
+                    positions[target] = static_cast<int>(contracted.targets.size());
+                    contracted.targets.push_back(target);
+                    contracted.weights.push_back(0);
+                }
+
+                contracted.weights[positions[target]] += m_graph.weights[i];
+            }
+        }
+
+        for (int i = begin; i < static_cast<int>(contracted.targets.size()); i++)
+        {
+            positions[contracted.targets[i]] = -1;
+        }
+
+        contracted.offsets[node + 1] = static_cast<int>(contracted.targets.size());
+    }
+
+    m_graph = std::move(contracted);
+}
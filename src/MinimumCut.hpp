@@ -0,0 +1,100 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+
+#pragma once
+
+#include <limits>
+#include <utility>
+#include <vector>
+#include "Graph.hpp"
+
+/**
+ * Deterministic global minimum edge cut of graph (Stoer-Wagner with Nagamochi-Ibaraki contractions)
+ * Every phase orders nodes of contracted graph by maximum adjacency using bucket queue
+ * Last node of the order gives cut of the phase, then last two nodes are merged together with
+ * every edge whose endpoints were shown to be connected at least as strongly as the best cut found
+ */
+class MinimumCut
+{
+
+protected:
+
+    /**
+     * Contracted graph in compressed sparse row form with edge multiplicities as weights
+     */
+    struct WeightedGraph
+    {
+        std::vector<int> offsets;
+        std::vector<int> targets;
+        std::vector<int> weights;
+    };
+
+    int m_degree;
+    WeightedGraph m_graph;
+    std::vector<int> m_owners;
+
+public:
+
+    /**
+     * Constructor by graph
+     * @param graph
+     */
+    explicit MinimumCut(const Graph& graph);
+
+public:
+
+    /**
+     * Computes size of minimum edge cut, graphs with less than two nodes have zero
+     * Cuts of at least given limit are not told apart, their size is reported as the limit
+     * @param side if given, receives ascending list of nodes on one side of found cut
+     * @param limit
+     * @return
+     */
+    int compute(std::vector<int>* side = nullptr, int limit = std::numeric_limits<int>::max());
+
+    /**
+     * Returns edges of Nagamochi-Ibaraki sparse certificate, union of first k forests of scan first search
+     * Certificate has at most k * (n - 1) edges and is k node and k edge continuous exactly when graph is
+     * @param graph
+     * @param k
+     * @param order if given, receives nodes in scanned order, each having all certificate edges to earlier nodes
+     *              or at least k of them
+     * @return
+     */
+    static std::vector<std::pair<int, int>> certificate(const Graph& graph, int k, std::vector<int>* order = nullptr);
+
+protected:
+
+    /**
+     * Orders nodes by maximum adjacency and marks edges which may be contracted
+     * @param bound size of best cut found so far, updated by cut of the phase
+     * @param parents union find forest of contracted nodes
+     * @param forests if given, receives edges scanned while key of their later endpoint was below bound
+     * @param order if given, receives nodes in order of maximum adjacency
+     * @return last node of the order, whose singleton cut is cut of the phase
+     */
+    int phase(int& bound, std::vector<int>& parents, std::vector<std::pair<int, int>>* forests = nullptr,
+              std::vector<int>* order = nullptr) const;
+
+    /**
+     * Replaces contracted graph by graph of union find classes
+     * @param parents
+     */
+    void contract(std::vector<int>& parents);
+};
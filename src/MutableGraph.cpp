@@ -16,59 +16,388 @@
 /* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
 /*                                                                          */
 
+#include <algorithm>
 #include "MutableGraph.hpp"
 
 void MutableGraph::addEdge(int index1, int index2) noexcept
 {
-    if (m_matrix[index1][index2])
+    if (m_batchDepth > 0 && m_sparse)
     {
+        m_pendingEdges.emplace_back(std::min(index1, index2), std::max(index1, index2), true);
         return;
     }
 
-    m_matrix[index1][index2] = true;
-    m_matrix[index2][index1] = true;
+    if (hasEdge(index1, index2))
+    {
+        return;
+    }
 
-    computeProperties();
+    if (m_sparse)
+    {
+        m_sparseMatrix.set(index1, index2);
+        m_sparseMatrix.set(index2, index1);
+    }
+    else
+    {
+        m_matrix.set(index1, index2);
+        m_matrix.set(index2, index1);
+    }
+
+    if (m_batchDepth > 0)
+    {
+        return;
+    }
+
+    incrementDegree(index1);
+    incrementDegree(index2);
+    m_size++;
+    m_solver->reset();
 }
 
 void MutableGraph::removeEdge(int index1, int index2) noexcept
 {
-    if (!m_matrix[index1][index2])
+    if (m_batchDepth > 0 && m_sparse)
     {
+        m_pendingEdges.emplace_back(std::min(index1, index2), std::max(index1, index2), false);
         return;
     }
 
-    m_matrix[index1][index2] = false;
-    m_matrix[index2][index1] = false;
+    if (!hasEdge(index1, index2))
+    {
+        return;
+    }
 
-    computeProperties();
+    if (m_sparse)
+    {
+        m_sparseMatrix.reset(index1, index2);
+        m_sparseMatrix.reset(index2, index1);
+    }
+    else
+    {
+        m_matrix.reset(index1, index2);
+        m_matrix.reset(index2, index1);
+    }
+
+    if (m_batchDepth > 0)
+    {
+        return;
+    }
+
+    decrementDegree(index1);
+    decrementDegree(index2);
+    m_size--;
+    m_solver->reset();
 }
 
 void MutableGraph::addNode() noexcept
 {
-    std::vector<bool> temp;
-    temp.reserve(getDegree() + 1);
-    temp.push_back(false);
+    applyPendingEdges();
 
-    for (auto& row : m_matrix)
+    if (m_sparse)
+    {
+        m_sparseMatrix.addNode();
+    }
+    else
     {
-        row.push_back(false);
-        temp.push_back(false);
+        m_matrix.addNode();
     }
 
-    m_matrix.push_back(temp);
+    if (m_batchDepth > 0)
+    {
+        return;
+    }
 
-    computeProperties();
+    m_degrees.push_back(0);
+    m_degreeCounts.push_back(0);
+    m_degreeCounts[0]++;
+    m_sortedDegreesValid = false;
+    m_minDegree = 0;
+    m_solver->reset();
 }
 
 void MutableGraph::removeNode(int index) noexcept
 {
-    for (int i = 0; i < getDegree(); i++)
+    applyPendingEdges();
+
+    if (m_batchDepth > 0)
+    {
+        if (m_sparse)
+        {
+            m_sparseMatrix.removeNode(index);
+        }
+        else
+        {
+            m_matrix.removeNode(index);
+        }
+
+        return;
+    }
+
+    for (int neighbour : getNodeNeighbourRange(index))
+    {
+        decrementDegree(neighbour);
+    }
+
+    m_degreeCounts[m_degrees[index]]--;
+    m_degreeCounts.pop_back();
+    m_sortedDegreesValid = false;
+    m_size -= m_degrees[index];
+    m_degrees.erase(m_degrees.begin() + index);
+
+    while (m_maxDegree > 0 && m_degreeCounts[m_maxDegree] == 0)
+    {
+        m_maxDegree--;
+    }
+
+    while (m_minDegree < m_maxDegree && m_degreeCounts[m_minDegree] == 0)
+    {
+        m_minDegree++;
+    }
+
+    if (m_sparse)
+    {
+        m_sparseMatrix.removeNode(index);
+    }
+    else
+    {
+        m_matrix.removeNode(index);
+    }
+
+    m_solver->reset();
+}
+
+void MutableGraph::removeNodes(std::vector<int> indices) noexcept
+{
+    applyPendingEdges();
+
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+    if (m_sparse)
+    {
+        m_sparseMatrix.removeNodes(indices);
+    }
+    else
+    {
+        m_matrix.removeNodes(indices);
+    }
+
+    if (m_batchDepth > 0)
+    {
+        return;
+    }
+
+    computeProperties();
+    m_solver->reset();
+}
+
+void MutableGraph::beginBatch() noexcept
+{
+    m_batchDepth++;
+}
+
+void MutableGraph::commitBatch() noexcept
+{
+    if (m_batchDepth == 0 || --m_batchDepth > 0)
+    {
+        return;
+    }
+
+    applyPendingEdges();
+    computeProperties();
+    m_solver->reset();
+}
+
+void MutableGraph::addEdges(const std::vector<std::pair<int, int>>& edges) noexcept
+{
+    beginBatch();
+
+    for (auto& edge : edges)
+    {
+        addEdge(edge.first, edge.second);
+    }
+
+    commitBatch();
+}
+
+void MutableGraph::removeEdges(const std::vector<std::pair<int, int>>& edges) noexcept
+{
+    beginBatch();
+
+    for (auto& edge : edges)
     {
-        m_matrix[i].erase(m_matrix[i].begin() + index);
+        removeEdge(edge.first, edge.second);
     }
 
-    m_matrix.erase(m_matrix.begin() + index);
+    commitBatch();
+}
+
+void MutableGraph::close(int k) noexcept
+{
+    applyPendingEdges();
+
+    if (m_sparse)
+    {
+        BitMatrix matrix = m_sparseMatrix.toBitMatrix(m_sparseMatrix.resource());
+        closeMatrix(matrix, k);
+        m_sparseMatrix = SparseMatrix(matrix, m_sparseMatrix.resource());
+    }
+    else
+    {
+        closeMatrix(m_matrix, k);
+    }
+
+    if (m_batchDepth > 0)
+    {
+        return;
+    }
 
     computeProperties();
+    m_solver->reset();
+}
+
+void MutableGraph::closeMatrix(BitMatrix& matrix, int k) noexcept
+{
+    const int size = matrix.size();
+    const int words = matrix.words();
+    std::pmr::vector<int> degrees(size, matrix.resource());
+    std::pmr::vector<int> queue(size, matrix.resource());
+    std::pmr::vector<char> queued(size, 1, matrix.resource());
+    int head = 0;
+    int count = size;
+    int maxDegree = 0;
+
+    for (int i = 0; i < size; i++)
+    {
+        degrees[i] = matrix.rowCount(i);
+        queue[i] = i;
+        maxDegree = std::max(maxDegree, degrees[i]);
+    }
+
+    // node is queued at most once at a time, so the queue is a ring of node count
+    while (count > 0)
+    {
+        const int node = queue[head];
+        bool grown = false;
+
+        head = (head + 1) % size;
+        count--;
+        queued[node] = 0;
+
+        // no pair of this node can qualify, growth of the other node queues it again
+        if (degrees[node] + maxDegree < k)
+        {
+            continue;
+        }
+
+        for (int w = 0; w < words; w++)
+        {
+            BitMatrix::Word missing = ~matrix.row(node)[w];
+
+            if (w == words - 1 && size % BitMatrix::WORD_BITS)
+            {
+                missing &= (BitMatrix::Word(1) << (size % BitMatrix::WORD_BITS)) - 1;
+            }
+
+            for (; missing; missing &= missing - 1)
+            {
+                const int other = w * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(missing);
+
+                if (other == node || degrees[node] + degrees[other] < k)
+                {
+                    continue;
+                }
+
+                matrix.set(node, other);
+                matrix.set(other, node);
+                degrees[node]++;
+                degrees[other]++;
+                maxDegree = std::max({maxDegree, degrees[node], degrees[other]});
+                grown = true;
+
+                if (!queued[other])
+                {
+                    queue[(head + count++) % size] = other;
+                    queued[other] = 1;
+                }
+            }
+        }
+
+        // pairs rejected earlier in the scan may qualify with the grown degree
+        if (grown)
+        {
+            queue[(head + count++) % size] = node;
+            queued[node] = 1;
+        }
+    }
+}
+
+void MutableGraph::applyPendingEdges() noexcept
+{
+    if (m_pendingEdges.empty())
+    {
+        return;
+    }
+
+    // last change of each node pair wins
+    std::stable_sort(m_pendingEdges.begin(), m_pendingEdges.end(), [](auto& a, auto& b) {
+        return std::tie(std::get<0>(a), std::get<1>(a)) < std::tie(std::get<0>(b), std::get<1>(b));
+    });
+
+    std::vector<std::pair<int, int>> added;
+    std::vector<std::pair<int, int>> removed;
+
+    for (int i = 0; i < static_cast<int>(m_pendingEdges.size()); i++)
+    {
+        auto& edge = m_pendingEdges[i];
+
+        if (i + 1 < static_cast<int>(m_pendingEdges.size()) &&
+            std::get<0>(m_pendingEdges[i + 1]) == std::get<0>(edge) && std::get<1>(m_pendingEdges[i + 1]) == std::get<1>(edge))
+        {
+            continue;
+        }
+
+        (std::get<2>(edge) ? added : removed).emplace_back(std::get<0>(edge), std::get<1>(edge));
+    }
+
+    m_sparseMatrix.update(added, removed);
+    m_pendingEdges.clear();
+}
+
+void MutableGraph::incrementDegree(int index) noexcept
+{
+    const int degree = m_degrees[index]++;
+
+    m_degreeCounts[degree]--;
+    m_degreeCounts[degree + 1]++;
+    m_sortedDegreesValid = false;
+
+    if (degree + 1 > m_maxDegree)
+    {
+        m_maxDegree = degree + 1;
+    }
+
+    if (degree == m_minDegree && m_degreeCounts[degree] == 0)
+    {
+        m_minDegree = degree + 1;
+    }
+}
+
+void MutableGraph::decrementDegree(int index) noexcept
+{
+    const int degree = m_degrees[index]--;
+
+    m_degreeCounts[degree]--;
+    m_degreeCounts[degree - 1]++;
+    m_sortedDegreesValid = false;
+
+    if (degree - 1 < m_minDegree)
+    {
+        m_minDegree = degree - 1;
+    }
+
+    if (degree == m_maxDegree && m_degreeCounts[degree] == 0)
+    {
+        m_maxDegree = degree - 1;
+    }
 }
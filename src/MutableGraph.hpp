@@ -18,12 +18,20 @@
 
 #pragma once
 
+#include <tuple>
+#include <utility>
+#include <vector>
 #include "Graph.hpp"
 
 class MutableGraph : public Graph
 {
     using Graph::Graph;
-    
+
+protected:
+
+    int m_batchDepth = 0;
+    std::vector<std::tuple<int, int, bool>> m_pendingEdges;
+
 public:
 
     /**
@@ -49,4 +57,80 @@ public:
      * Removes node at given index
      */
     void removeNode(int index) noexcept;
+
+    /**
+     * Removes nodes at given indices at once
+     * @param indices
+     */
+    void removeNodes(std::vector<int> indices) noexcept;
+
+public:
+
+    /*
+     * BATCH MUTATIONS
+     */
+
+    /**
+     * Starts batch of mutations, derived properties are recomputed once on commit
+     * Degrees and size are stale until commit, sparse graphs also defer edge changes until commit
+     */
+    void beginBatch() noexcept;
+
+    /**
+     * Finishes batch of mutations and recomputes derived properties
+     */
+    void commitBatch() noexcept;
+
+    /**
+     * Adds new edges between given pairs of nodes
+     * @param edges
+     */
+    void addEdges(const std::vector<std::pair<int, int>>& edges) noexcept;
+
+    /**
+     * Removes edges between given pairs of nodes
+     * @param edges
+     */
+    void removeEdges(const std::vector<std::pair<int, int>>& edges) noexcept;
+
+public:
+
+    /*
+     * CLOSURE
+     */
+
+    /**
+     * Replaces graph by its k-closure
+     * Non adjacent nodes with degree sum at least k are joined until no such pair remains
+     * Graph is Hamiltonian iff its n-closure is (Bondy-Chvátal)
+     * @param k
+     */
+    void close(int k) noexcept;
+
+protected:
+
+    /**
+     * Joins non adjacent pairs of rows with degree sum at least k until no such pair remains
+     * Node is revisited only after its degree grows, so each pair is checked again only when it may qualify
+     * @param matrix
+     * @param k
+     */
+    static void closeMatrix(BitMatrix& matrix, int k) noexcept;
+
+    /**
+     * Applies edge changes deferred during batch on sparse graph
+     */
+    void applyPendingEdges() noexcept;
+
+    /**
+     * Increments degree of node at given index, keeping degree bounds up to date
+     * @param index
+     */
+    void incrementDegree(int index) noexcept;
+
+    /**
+     * Decrements degree of node at given index, keeping degree bounds up to date
+     * @param index
+     */
+    void decrementDegree(int index) noexcept;
 };
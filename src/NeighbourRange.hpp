@@ -0,0 +1,184 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include "BitMatrix.hpp"
+#include "SparseMatrix.hpp"
+
+/**
+ * Forward iterator over neighbour indices of single node
+ * Walks set bits of dense row word by word or entries of sparse row
+ */
+class NeighbourIterator
+{
+
+public:
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = int;
+
+protected:
+
+    const BitMatrix::Word* m_row;
+    const int* m_position;
+    int m_wordIndex;
+    int m_wordCount;
+    BitMatrix::Word m_word;
+
+public:
+
+    /**
+     * Constructor of iterator over dense row, starting at given word
+     * @param row
+     * @param wordIndex
+     * @param wordCount
+     */
+    NeighbourIterator(const BitMatrix::Word* row, int wordIndex, int wordCount) noexcept :
+        m_row(row),
+        m_position(nullptr),
+        m_wordIndex(wordIndex),
+        m_wordCount(wordCount),
+        m_word(wordIndex < wordCount ? row[wordIndex] : 0)
+    {
+        skipEmptyWords();
+    }
+
+    /**
+     * Constructor of iterator over sparse row
+     * @param position
+     */
+    explicit NeighbourIterator(const int* position) noexcept :
+        m_row(nullptr),
+        m_position(position),
+        m_wordIndex(0),
+        m_wordCount(0),
+        m_word(0)
+    {}
+
+public:
+
+    int operator*() const noexcept
+    {
+        if (m_position)
+        {
+            return *m_position;
+        }
+
+        return m_wordIndex * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(m_word);
+    }
+
+    NeighbourIterator& operator++() noexcept
+    {
+        if (m_position)
+        {
+            m_position++;
+            return *this;
+        }
+
+        m_word &= m_word - 1;
+        skipEmptyWords();
+
+        return *this;
+    }
+
+    NeighbourIterator operator++(int) noexcept
+    {
+        NeighbourIterator temp = *this;
+        ++*this;
+
+        return temp;
+    }
+
+    bool operator==(const NeighbourIterator& other) const noexcept
+    {
+        return m_position == other.m_position && m_wordIndex == other.m_wordIndex && m_word == other.m_word;
+    }
+
+    bool operator!=(const NeighbourIterator& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+protected:
+
+    /**
+     * Moves to next word with any bit set, or to the end of row
+     */
+    void skipEmptyWords() noexcept
+    {
+        while (m_word == 0 && m_wordIndex < m_wordCount)
+        {
+            if (++m_wordIndex < m_wordCount)
+            {
+                m_word = m_row[m_wordIndex];
+            }
+        }
+    }
+};
+
+/**
+ * Range of neighbour indices of single node, usable in range based for without allocation
+ */
+class NeighbourRange
+{
+
+protected:
+
+    NeighbourIterator m_begin;
+    NeighbourIterator m_end;
+
+public:
+
+    /**
+     * Constructor by dense row
+     * @param matrix
+     * @param index
+     */
+    NeighbourRange(const BitMatrix& matrix, int index) noexcept :
+        m_begin(matrix.row(index), 0, matrix.words()),
+        m_end(matrix.row(index), matrix.words(), matrix.words())
+    {}
+
+    /**
+     * Constructor by sparse row
+     * @param matrix
+     * @param index
+     */
+    NeighbourRange(const SparseMatrix& matrix, int index) noexcept :
+        m_begin(matrix.rowBegin(index)),
+        m_end(matrix.rowEnd(index))
+    {}
+
+public:
+
+    NeighbourIterator begin() const noexcept
+    {
+        return m_begin;
+    }
+
+    NeighbourIterator end() const noexcept
+    {
+        return m_end;
+    }
+};
@@ -0,0 +1,378 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+
+#include "NodeFlowNetwork.hpp"
+
+NodeFlowNetwork::NodeFlowNetwork(const Graph& graph) :
+    m_degree(graph.getDegree()),
+    m_offsets(2 * graph.getDegree() + 1, 0)
+{
+    // entry of node v is 2v, exit 2v + 1, both have arc to each other and one arc per neighbour
+    for (int i = 0; i < m_degree; i++)
+    {
+        m_offsets[2 * i + 1] = m_offsets[2 * i] + graph.getNodeDegree(i) + 1;
+        m_offsets[2 * i + 2] = m_offsets[2 * i + 1] + graph.getNodeDegree(i) + 1;
+    }
+
+    m_targets.resize(m_offsets.back());
+    m_reverse.resize(m_offsets.back());
+    m_capacities.assign(m_offsets.back(), 0);
+
+    for (int i = 0; i < m_degree; i++)
+    {
+        const int entry = m_offsets[2 * i];
+        const int exit = m_offsets[2 * i + 1];
+
+        m_targets[entry] = 2 * i + 1;
+        m_reverse[entry] = exit;
+        m_capacities[entry] = 1;
+        m_targets[exit] = 2 * i;
+        m_reverse[exit] = entry;
+    }
+
+    // neighbour lists are ascending, so position of i among neighbours of v is the count of smaller ones seen so far
+    std::vector<int> cursors(m_degree, 0);
+
+    for (int i = 0; i < m_degree; i++)
+    {
+        int k = 0;
+
+        for (int neighbour : graph.getNodeNeighbourRange(i))
+        {
+            const int forward = m_offsets[2 * i + 1] + 1 + k++;
+            const int backward = m_offsets[2 * neighbour] + 1 + cursors[neighbour]++;
+
+            m_targets[forward] = 2 * neighbour;
+            m_reverse[forward] = backward;
+            m_capacities[forward] = 1;
+            m_targets[backward] = 2 * i + 1;
+            m_reverse[backward] = forward;
+        }
+    }
+}
+
+void NodeFlowNetwork::prepare(Workspace& workspace) const
+{
+    // only arcs on previous augmenting paths differ from capacities
+    if (workspace.residual.size() != m_capacities.size())
+    {
+        workspace.residual.assign(m_capacities.begin(), m_capacities.end());
+        workspace.changed.clear();
+    }
+
+    for (int arc : workspace.changed)
+    {
+        workspace.residual[arc] = m_capacities[arc];
+    }
+
+    workspace.changed.clear();
+    workspace.parentArc.resize(2 * m_degree);
+    workspace.marks.resize(2 * m_degree, 0);
+    workspace.queue.reserve(2 * m_degree);
+    workspace.backArc.resize(2 * m_degree);
+    workspace.backMarks.resize(2 * m_degree, 0);
+}
+
+int NodeFlowNetwork::countPaths(int source, int target, int limit, Workspace& workspace) const
+{
+    prepare(workspace);
+
+    // flow leaves exit of source and arrives to entry of target, their inner arcs are never needed
+    int paths = seedPaths(source, target, limit, workspace);
+
+    while (paths < limit && augment(2 * source + 1, 2 * target, workspace))
+    {
+        paths++;
+    }
+
+    return paths;
+}
+
+int NodeFlowNetwork::countFanPaths(int source, const std::vector<int>& ranks, int bound, int limit,
+                                   Workspace& workspace) const
+{
+    prepare(workspace);
+
+    // path ends by inner arc of sink, which is saturated afterwards and so absorbs single path only
+    int paths = seedFanPaths(source, ranks, bound, limit, workspace);
+
+    while (paths < limit && augmentFan(2 * source + 1, ranks, bound, workspace))
+    {
+        paths++;
+    }
+
+    return paths;
+}
+
+int NodeFlowNetwork::seedPaths(int source, int target, int limit, Workspace& workspace) const
+{
+    const int stamp = ++workspace.stamp;
+    const int from = 2 * source + 1;
+    int paths = 0;
+
+    // exits of neighbours of target remember their arc to it, entries of used nodes are marked
+    for (int arc = m_offsets[2 * target] + 1; arc < m_offsets[2 * target + 1]; arc++)
+    {
+        workspace.backMarks[m_targets[arc]] = stamp;
+        workspace.backArc[m_targets[arc]] = m_reverse[arc];
+    }
+
+    // common neighbours first, each of them closes path of length two
+    for (int arc = m_offsets[from] + 1; arc < m_offsets[from + 1] && paths < limit; arc++)
+    {
+        const int entry = m_targets[arc];
+
+        if (workspace.backMarks[entry + 1] == stamp)
+        {
+            push(arc, workspace);
+            push(m_offsets[entry], workspace);
+            push(workspace.backArc[entry + 1], workspace);
+            workspace.marks[entry] = stamp;
+            paths++;
+        }
+    }
+
+    // then single inner step from remaining neighbour to unused neighbour of target
+    for (int arc = m_offsets[from] + 1; arc < m_offsets[from + 1] && paths < limit; arc++)
+    {
+        const int entry = m_targets[arc];
+
+        if (workspace.marks[entry] == stamp)
+        {
+            continue;
+        }
+
+        for (int inner = m_offsets[entry + 1] + 1; inner < m_offsets[entry + 2]; inner++)
+        {
+            const int next = m_targets[inner];
+
+            if (workspace.marks[next] != stamp && workspace.backMarks[next + 1] == stamp && next != from - 1)
+            {
+                push(arc, workspace);
+                push(m_offsets[entry], workspace);
+                push(inner, workspace);
+                push(m_offsets[next], workspace);
+                push(workspace.backArc[next + 1], workspace);
+                workspace.marks[entry] = stamp;
+                workspace.marks[next] = stamp;
+                paths++;
+                break;
+            }
+        }
+    }
+
+    return paths;
+}
+
+int NodeFlowNetwork::seedFanPaths(int source, const std::vector<int>& ranks, int bound, int limit,
+                                  Workspace& workspace) const
+{
+    const int stamp = ++workspace.stamp;
+    const int from = 2 * source + 1;
+    int paths = 0;
+
+    // sinks among neighbours first, each of them ends path of length one
+    for (int arc = m_offsets[from] + 1; arc < m_offsets[from + 1] && paths < limit; arc++)
+    {
+        const int entry = m_targets[arc];
+
+        if (ranks[entry >> 1] < bound)
+        {
+            push(arc, workspace);
+            push(m_offsets[entry], workspace);
+            workspace.marks[entry] = stamp;
+            paths++;
+        }
+    }
+
+    // then single step from remaining neighbour to unused sink
+    for (int arc = m_offsets[from] + 1; arc < m_offsets[from + 1] && paths < limit; arc++)
+    {
+        const int entry = m_targets[arc];
+
+        if (workspace.marks[entry] == stamp)
+        {
+            continue;
+        }
+
+        for (int inner = m_offsets[entry + 1] + 1; inner < m_offsets[entry + 2]; inner++)
+        {
+            const int next = m_targets[inner];
+
+            if (workspace.marks[next] != stamp && ranks[next >> 1] < bound)
+            {
+                push(arc, workspace);
+                push(m_offsets[entry], workspace);
+                push(inner, workspace);
+                push(m_offsets[next], workspace);
+                workspace.marks[entry] = stamp;
+                workspace.marks[next] = stamp;
+                paths++;
+                break;
+            }
+        }
+    }
+
+    return paths;
+}
+
+bool NodeFlowNetwork::augment(int from, int to, Workspace& workspace) const
+{
+    const int stamp = ++workspace.stamp;
+    int meeting = -1;
+
+    workspace.queue.assign(1, from);
+    workspace.backQueue.assign(1, to);
+    workspace.marks[from] = stamp;
+    workspace.backMarks[to] = stamp;
+
+    while (meeting == -1 && !workspace.queue.empty() && !workspace.backQueue.empty())
+    {
+        workspace.frontier.clear();
+
+        if (workspace.queue.size() <= workspace.backQueue.size())
+        {
+            // forward level follows arcs with residual capacity
+            for (int i = 0; i < static_cast<int>(workspace.queue.size()) && meeting == -1; i++)
+            {
+                const int node = workspace.queue[i];
+
+                for (int arc = m_offsets[node]; arc < m_offsets[node + 1]; arc++)
+                {
+                    const int next = m_targets[arc];
+
+                    if (!workspace.residual[arc] || workspace.marks[next] == stamp)
+                    {
+                        continue;
+                    }
+
+                    workspace.marks[next] = stamp;
+                    workspace.parentArc[next] = arc;
+
+                    if (workspace.backMarks[next] == stamp)
+                    {
+                        meeting = next;
+                        break;
+                    }
+
+                    workspace.frontier.push_back(next);
+                }
+            }
+
+            workspace.queue.swap(workspace.frontier);
+        }
+        else
+        {
+            // backward level follows arcs stored at their target through their reverse
+            for (int i = 0; i < static_cast<int>(workspace.backQueue.size()) && meeting == -1; i++)
+            {
+                const int node = workspace.backQueue[i];
+
+                for (int arc = m_offsets[node]; arc < m_offsets[node + 1]; arc++)
+                {
+                    const int previous = m_targets[arc];
+                    const int incoming = m_reverse[arc];
+
+                    if (!workspace.residual[incoming] || workspace.backMarks[previous] == stamp)
+                    {
+                        continue;
+                    }
+
+                    workspace.backMarks[previous] = stamp;
+                    workspace.backArc[previous] = incoming;
+
+                    if (workspace.marks[previous] == stamp)
+                    {
+                        meeting = previous;
+                        break;
+                    }
+
+                    workspace.frontier.push_back(previous);
+                }
+            }
+
+            workspace.backQueue.swap(workspace.frontier);
+        }
+    }
+
+    if (meeting == -1)
+    {
+        return false;
+    }
+
+    for (int current = meeting; current != from; current = m_targets[m_reverse[workspace.parentArc[current]]])
+    {
+        push(workspace.parentArc[current], workspace);
+    }
+
+    for (int current = meeting; current != to; current = m_targets[workspace.backArc[current]])
+    {
+        push(workspace.backArc[current], workspace);
+    }
+
+    return true;
+}
+
+bool NodeFlowNetwork::augmentFan(int from, const std::vector<int>& ranks, int bound, Workspace& workspace) const
+{
+    const int stamp = ++workspace.stamp;
+
+    workspace.queue.assign(1, from);
+    workspace.marks[from] = stamp;
+
+    for (int head = 0; head < static_cast<int>(workspace.queue.size()); head++)
+    {
+        const int node = workspace.queue[head];
+
+        for (int arc = m_offsets[node]; arc < m_offsets[node + 1]; arc++)
+        {
+            const int next = m_targets[arc];
+
+            if (!workspace.residual[arc] || workspace.marks[next] == stamp)
+            {
+                continue;
+            }
+
+            workspace.marks[next] = stamp;
+            workspace.parentArc[next] = arc;
+
+            if ((next & 1) && ranks[next >> 1] < bound)
+            {
+                for (int current = next; current != from; current = m_targets[m_reverse[workspace.parentArc[current]]])
+                {
+                    push(workspace.parentArc[current], workspace);
+                }
+
+                return true;
+            }
+
+            workspace.queue.push_back(next);
+        }
+    }
+
+    return false;
+}
+
+void NodeFlowNetwork::push(int arc, Workspace& workspace) const
+{
+    workspace.residual[arc]--;
+    workspace.residual[m_reverse[arc]]++;
+    workspace.changed.push_back(arc);
+    workspace.changed.push_back(m_reverse[arc]);
+}
@@ -0,0 +1,150 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+
+#pragma once
+
+#include <vector>
+#include "Graph.hpp"
+
+/**
+ * Unit capacity flow network of graph, every node is split into entry and exit joined by arc of capacity one
+ * Maximal flow between two non adjacent nodes equals the number of their internally node disjoint paths (Menger)
+ * Augmenting paths between two nodes are searched from both ends, meeting halfway explores far fewer nodes
+ */
+class NodeFlowNetwork
+{
+
+public:
+
+    /**
+     * Per thread state of single flow computation
+     */
+    struct Workspace
+    {
+        std::vector<char> residual;
+        std::vector<int> changed;
+        std::vector<int> parentArc;
+        std::vector<int> marks;
+        std::vector<int> queue;
+        std::vector<int> backArc;
+        std::vector<int> backMarks;
+        std::vector<int> backQueue;
+        std::vector<int> frontier;
+        int stamp = 0;
+    };
+
+protected:
+
+    int m_degree;
+    std::vector<int> m_offsets;
+    std::vector<int> m_targets;
+    std::vector<int> m_reverse;
+    std::vector<char> m_capacities;
+
+public:
+
+    /**
+     * Constructor by graph
+     * @param graph
+     */
+    explicit NodeFlowNetwork(const Graph& graph);
+
+public:
+
+    /**
+     * Returns number of internally node disjoint paths between given non adjacent nodes
+     * Augmenting stops once given limit is reached
+     * @param source
+     * @param target
+     * @param limit
+     * @param workspace
+     * @return
+     */
+    int countPaths(int source, int target, int limit, Workspace& workspace) const;
+
+    /**
+     * Returns number of paths from given node to distinct sinks, disjoint apart from the source (fan)
+     * Sinks are nodes ranked below given bound, augmenting stops once given limit is reached
+     * @param source
+     * @param ranks
+     * @param bound
+     * @param limit
+     * @param workspace
+     * @return
+     */
+    int countFanPaths(int source, const std::vector<int>& ranks, int bound, int limit, Workspace& workspace) const;
+
+protected:
+
+    /**
+     * Restores residual capacities changed by previous flow computation
+     * @param workspace
+     */
+    void prepare(Workspace& workspace) const;
+
+    /**
+     * Pushes flow greedily along node disjoint paths of length two and three between given nodes
+     * Augmenting then only completes the few paths left, every path found is one of them
+     * @param source
+     * @param target
+     * @param limit
+     * @param workspace
+     * @return number of paths pushed
+     */
+    int seedPaths(int source, int target, int limit, Workspace& workspace) const;
+
+    /**
+     * Pushes flow greedily along paths of length one and two from given node to distinct sinks
+     * @param source
+     * @param ranks
+     * @param bound
+     * @param limit
+     * @param workspace
+     * @return number of paths pushed
+     */
+    int seedFanPaths(int source, const std::vector<int>& ranks, int bound, int limit, Workspace& workspace) const;
+
+    /**
+     * Finds augmenting path by bidirectional breadth first search and pushes unit of flow along it
+     * Smaller of both frontiers is expanded by whole level until the searches meet
+     * @param from
+     * @param to
+     * @param workspace
+     * @return false when no augmenting path exists
+     */
+    bool augment(int from, int to, Workspace& workspace) const;
+
+    /**
+     * Finds augmenting path by breadth first search ending at exit of any node ranked below given bound
+     * and pushes unit of flow along it
+     * @param from
+     * @param ranks
+     * @param bound
+     * @param workspace
+     * @return false when no augmenting path exists
+     */
+    bool augmentFan(int from, const std::vector<int>& ranks, int bound, Workspace& workspace) const;
+
+    /**
+     * Pushes unit of flow along arc and records it for later reset
+     * @param arc
+     * @param workspace
+     */
+    void push(int arc, Workspace& workspace) const;
+};
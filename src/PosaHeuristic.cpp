@@ -0,0 +1,177 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+
+#include <algorithm>
+#include "PosaHeuristic.hpp"
+
+PosaHeuristic::PosaHeuristic(const Graph& graph, std::uint32_t seed) :
+    m_graph(graph),
+    m_offsets(graph.getDegree() + 1, 0),
+    m_positions(graph.getDegree(), -1),
+    m_random(seed)
+{
+    for (int i = 0; i < graph.getDegree(); i++)
+    {
+        m_offsets[i + 1] = m_offsets[i] + graph.getNodeDegree(i);
+    }
+
+    m_targets.reserve(m_offsets.back());
+
+    for (int i = 0; i < graph.getDegree(); i++)
+    {
+        for (int neighbour : graph.getNodeNeighbourRange(i))
+        {
+            m_targets.push_back(neighbour);
+        }
+    }
+
+    m_path.reserve(graph.getDegree());
+}
+
+SearchResult PosaHeuristic::find(bool route, std::vector<int>& result, int iterations, std::chrono::milliseconds time)
+{
+    const int degree = m_graph.getDegree();
+
+    // single node is a route on its own, circle needs two edges at every node
+    const int minDegree = route ? (degree > 1 ? 1 : 0) : 2;
+
+    result.clear();
+
+    if (degree < (route ? 1 : 3) || m_graph.getMinDegree() < minDegree)
+    {
+        return SearchResult::INCONCLUSIVE;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + time;
+    const int patience = std::max(64, 4 * degree);
+    int stalled = 0;
+
+    restart();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        if ((i & 1023) == 1023 && std::chrono::steady_clock::now() > deadline)
+        {
+            break;
+        }
+
+        if (static_cast<int>(m_path.size()) == degree)
+        {
+            if (route || m_graph.hasEdge(m_path.back(), m_path.front()))
+            {
+                result = m_path;
+                return SearchResult::FOUND;
+            }
+        }
+        else if (extend())
+        {
+            stalled = 0;
+            continue;
+        }
+
+        if (++stalled > patience || !rotate())
+        {
+            restart();
+            stalled = 0;
+        }
+    }
+
+    return SearchResult::INCONCLUSIVE;
+}
+
+void PosaHeuristic::restart()
+{
+    for (int node : m_path)
+    {
+        m_positions[node] = -1;
+    }
+
+    m_path.assign(1, random(m_graph.getDegree()));
+    m_positions[m_path.back()] = 0;
+}
+
+bool PosaHeuristic::extend()
+{
+    const int end = m_path.back();
+    const int count = m_offsets[end + 1] - m_offsets[end];
+
+    if (count == 0)
+    {
+        return false;
+    }
+
+    // scan starts at random neighbour so that restarts explore different paths
+    const int first = random(count);
+
+    for (int i = 0; i < count; i++)
+    {
+        const int neighbour = m_targets[m_offsets[end] + (first + i) % count];
+
+        if (m_positions[neighbour] == -1)
+        {
+            m_positions[neighbour] = static_cast<int>(m_path.size());
+            m_path.push_back(neighbour);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool PosaHeuristic::rotate()
+{
+    const int end = m_path.back();
+    const int count = m_offsets[end + 1] - m_offsets[end];
+    const int last = static_cast<int>(m_path.size()) - 1;
+
+    if (count < 2)
+    {
+        return false;
+    }
+
+    // predecessor of end is the only neighbour which does not rotate the path
+    int index = random(count);
+
+    if (m_positions[m_targets[m_offsets[end] + index]] == last - 1)
+    {
+        index = (index + 1) % count;
+    }
+
+    const int pivot = m_targets[m_offsets[end] + index];
+
+    if (m_positions[pivot] == -1 || m_positions[pivot] >= last - 1)
+    {
+        return false;
+    }
+
+    // path p0 .. pivot, next .. end becomes p0 .. pivot, end .. next
+    std::reverse(m_path.begin() + m_positions[pivot] + 1, m_path.end());
+
+    for (int i = m_positions[pivot] + 1; i <= last; i++)
+    {
+        m_positions[m_path[i]] = i;
+    }
+
+    return true;
+}
+
+int PosaHeuristic::random(int bound)
+{
+    return std::uniform_int_distribution<int>(0, bound - 1)(m_random);
+}
@@ -0,0 +1,100 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Graph.hpp"
+#include "SearchResult.hpp"
+
+/**
+ * Randomized Pósa rotation-extension heuristic for Hamilton circle and route
+ * Path is extended by free neighbour of its end while possible, otherwise it is rotated
+ * by edge from its end to inner node, which changes the end without shortening the path
+ * Search is restarted from random node when path does not grow for too long
+ */
+class PosaHeuristic
+{
+
+public:
+
+    /**
+     * Seed of random generator, fixed so that results are reproducible
+     */
+    static constexpr std::uint32_t DEFAULT_SEED = 1963;
+
+protected:
+
+    const Graph& m_graph;
+    std::vector<int> m_offsets;
+    std::vector<int> m_targets;
+    std::vector<int> m_path;
+    std::vector<int> m_positions;
+    std::mt19937 m_random;
+
+public:
+
+    /**
+     * Constructor by graph
+     * @param graph
+     * @param seed
+     */
+    explicit PosaHeuristic(const Graph& graph, std::uint32_t seed = DEFAULT_SEED);
+
+public:
+
+    /**
+     * Looks for Hamilton circle or route within given budget
+     * @param route search for route instead of circle
+     * @param result receives order of nodes of found circle or route
+     * @param iterations maximal number of extensions and rotations
+     * @param time maximal duration of search
+     * @return
+     */
+    SearchResult find(bool route, std::vector<int>& result, int iterations, std::chrono::milliseconds time);
+
+protected:
+
+    /**
+     * Starts new path in random node
+     */
+    void restart();
+
+    /**
+     * Appends free neighbour of path end to path
+     * @return false when path end has no free neighbour
+     */
+    bool extend();
+
+    /**
+     * Rotates path by edge from its end to random inner node
+     * @return false when path end has no such edge
+     */
+    bool rotate();
+
+    /**
+     * Returns random integer from interval [0, bound)
+     * @param bound
+     * @return
+     */
+    int random(int bound);
+};
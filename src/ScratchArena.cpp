@@ -0,0 +1,52 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#include "ScratchArena.hpp"
+
+void* ScratchArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    m_allocations++;
+    m_used += bytes + alignment;
+
+    return m_resource->allocate(bytes, alignment);
+}
+
+void ScratchArena::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment)
+{
+    m_resource->deallocate(pointer, bytes, alignment);
+}
+
+void ScratchArena::release()
+{
+    m_lastAllocations = m_allocations;
+    m_lastUpstreamAllocations = m_upstream.m_allocations;
+    m_allocations = 0;
+    m_upstream.m_allocations = 0;
+
+    m_resource->release();
+
+    // next query of the same size is served from initial buffer only
+    if (m_used > m_buffer.size())
+    {
+        m_resource.reset();
+        m_buffer.resize(m_used);
+        m_resource.emplace(m_buffer.data(), m_buffer.size(), &m_upstream);
+    }
+
+    m_used = 0;
+}
@@ -0,0 +1,152 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+/**
+ * Monotonic memory resource for temporary objects created while solving a single query
+ * Memory is released when outermost scope ends, buffer grows to fit the largest query seen
+ * Not thread safe
+ */
+class ScratchArena : public std::pmr::memory_resource
+{
+
+protected:
+
+    /**
+     * Upstream resource counting allocations which reach the heap
+     */
+    class CountingResource : public std::pmr::memory_resource
+    {
+
+    public:
+
+        int m_allocations = 0;
+
+    protected:
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            m_allocations++;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    CountingResource m_upstream;
+    std::vector<std::byte> m_buffer;
+    std::optional<std::pmr::monotonic_buffer_resource> m_resource;
+
+    int m_depth = 0;
+    std::size_t m_used = 0;
+    int m_allocations = 0;
+    int m_lastAllocations = 0;
+    int m_lastUpstreamAllocations = 0;
+
+public:
+
+    ScratchArena()
+    {
+        m_resource.emplace(&m_upstream);
+    }
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+public:
+
+    /**
+     * Guard of single query, arena is released when outermost scope ends
+     */
+    class Scope
+    {
+
+    protected:
+
+        ScratchArena& m_arena;
+
+    public:
+
+        explicit Scope(ScratchArena& arena) noexcept :
+            m_arena(arena)
+        {
+            m_arena.m_depth++;
+        }
+
+        ~Scope()
+        {
+            if (--m_arena.m_depth == 0)
+            {
+                m_arena.release();
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+public:
+
+    /**
+     * Returns number of allocations served during last finished query
+     * @return
+     */
+    int getLastQueryAllocations() const noexcept
+    {
+        return m_lastAllocations;
+    }
+
+    /**
+     * Returns number of allocations which reached the heap during last finished query
+     * @return
+     */
+    int getLastQueryUpstreamAllocations() const noexcept
+    {
+        return m_lastUpstreamAllocations;
+    }
+
+protected:
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    /**
+     * Releases all memory and records statistics of finished query
+     */
+    void release();
+};
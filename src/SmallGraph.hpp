@@ -0,0 +1,388 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "BitMatrix.hpp"
+#include "Graph.hpp"
+
+/**
+ * Graph with at most N nodes, each adjacency row is stored in single machine word
+ */
+template <int N>
+class SmallGraph
+{
+    static_assert(N > 0 && N <= BitMatrix::WORD_BITS, "SmallGraph row must fit into single word");
+
+public:
+
+    using Row = BitMatrix::Word;
+
+protected:
+
+    std::array<Row, N> m_rows;
+    int m_degree;
+
+public:
+
+    /**
+     * Constructor of graph with given number of nodes and zero edges
+     * @param degree
+     */
+    explicit constexpr SmallGraph(int degree = N) noexcept :
+        m_rows(),
+        m_degree(degree)
+    {}
+
+    /**
+     * Constructor by dynamic graph with at most N nodes
+     * @param graph
+     */
+    explicit SmallGraph(const Graph& graph) noexcept :
+        m_rows(),
+        m_degree(graph.getDegree())
+    {
+        for (int i = 0; i < m_degree; i++)
+        {
+            for (int neighbour : graph.getNodeNeighbourRange(i))
+            {
+                m_rows[i] |= bit(neighbour);
+            }
+        }
+    }
+
+public:
+
+    /**
+     * Returns maximal number of nodes
+     * @return
+     */
+    static constexpr int capacity() noexcept
+    {
+        return N;
+    }
+
+    /**
+     * Returns row with single bit set at given index
+     * @param index
+     * @return
+     */
+    static constexpr Row bit(int index) noexcept
+    {
+        return Row(1) << index;
+    }
+
+    /**
+     * Returns row with bits of all indices above given index set
+     * @param index
+     * @return
+     */
+    static constexpr Row above(int index) noexcept
+    {
+        return ~((bit(index) << 1) - 1);
+    }
+
+public:
+
+    /**
+     * Returns graphs degree (number of nodes)
+     * @return
+     */
+    constexpr int getDegree() const noexcept
+    {
+        return m_degree;
+    }
+
+    /**
+     * Returns row with bits of all nodes set
+     * @return
+     */
+    constexpr Row getNodes() const noexcept
+    {
+        return m_degree == BitMatrix::WORD_BITS ? ~Row(0) : bit(m_degree) - 1;
+    }
+
+    /**
+     * Returns row with bits of neighbours of node at given index set
+     * @param index
+     * @return
+     */
+    constexpr Row getNeighbours(int index) const noexcept
+    {
+        return m_rows[index];
+    }
+
+    /**
+     * Returns degree of node at given index
+     * @param index
+     * @return
+     */
+    constexpr int getNodeDegree(int index) const noexcept
+    {
+        return BitMatrix::popcount(m_rows[index]);
+    }
+
+    /**
+     * Returns whether exists edge between nodes at given indices
+     * @param index1
+     * @param index2
+     * @return
+     */
+    constexpr bool hasEdge(int index1, int index2) const noexcept
+    {
+        return (m_rows[index1] & bit(index2)) != 0;
+    }
+
+    /**
+     * Adds new edge between given nodes
+     * @param index1
+     * @param index2
+     */
+    constexpr void addEdge(int index1, int index2) noexcept
+    {
+        m_rows[index1] |= bit(index2);
+        m_rows[index2] |= bit(index1);
+    }
+
+    /**
+     * Removes edge between given nodes
+     * @param index1
+     * @param index2
+     */
+    constexpr void removeEdge(int index1, int index2) noexcept
+    {
+        m_rows[index1] &= ~bit(index2);
+        m_rows[index2] &= ~bit(index1);
+    }
+
+public:
+
+    /**
+     * Returns nodes reachable from given node using only nodes from given mask
+     * @param index
+     * @param mask
+     * @return
+     */
+    constexpr Row reachable(int index, Row mask) const noexcept
+    {
+        Row reached = bit(index);
+        Row frontier = reached;
+
+        while (frontier)
+        {
+            Row next = 0;
+
+            for (Row rest = frontier; rest; rest &= rest - 1)
+            {
+                next |= m_rows[BitMatrix::countTrailingZeros(rest)];
+            }
+
+            frontier = next & mask & ~reached;
+            reached |= frontier;
+        }
+
+        return reached;
+    }
+
+    /**
+     * Returns whether graph is continuous
+     * @return
+     */
+    constexpr bool isContinuous() const noexcept
+    {
+        return m_degree == 0 || reachable(0, getNodes()) == getNodes();
+    }
+
+    /**
+     * Returns whether graph has K13 as induced subgraph
+     * @return
+     */
+    constexpr bool hasClaw() const noexcept
+    {
+        for (int i = 0; i < m_degree; i++)
+        {
+            for (Row first = m_rows[i]; first; first &= first - 1)
+            {
+                const int a = BitMatrix::countTrailingZeros(first);
+
+                // neighbours of centre above a, not adjacent to a
+                Row second = m_rows[i] & ~m_rows[a] & above(a);
+
+                for (; second; second &= second - 1)
+                {
+                    const int b = BitMatrix::countTrailingZeros(second);
+
+                    if (second & ~m_rows[b] & above(b))
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Returns whether graph contains Hamilton route
+     * @return
+     */
+    constexpr bool hasHamiltonRoute() const noexcept
+    {
+        if (m_degree == 0 || !isContinuous())
+        {
+            return false;
+        }
+
+        // route has to start in node of degree one if there is any
+        Row starts = 0;
+
+        for (int i = 0; i < m_degree; i++)
+        {
+            if (getNodeDegree(i) == 1)
+            {
+                starts |= bit(i);
+            }
+        }
+
+        if (BitMatrix::popcount(starts) > 2)
+        {
+            return false;
+        }
+
+        for (Row rest = starts ? starts : getNodes(); rest; rest &= rest - 1)
+        {
+            const int start = BitMatrix::countTrailingZeros(rest);
+
+            if (extendRoute(start, bit(start)))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Returns whether graph contains Hamilton circle
+     * @return
+     */
+    constexpr bool hasHamiltonCircle() const noexcept
+    {
+        if (m_degree < 3 || !isContinuous())
+        {
+            return false;
+        }
+
+        return extendCircle(0, bit(0));
+    }
+
+protected:
+
+    /**
+     * Depth first extension of path ending in given node towards Hamilton route
+     * @param end
+     * @param visited
+     * @return
+     */
+    constexpr bool extendRoute(int end, Row visited) const noexcept
+    {
+        const Row unvisited = getNodes() & ~visited;
+
+        if (!unvisited)
+        {
+            return true;
+        }
+
+        if ((reachable(end, unvisited) & unvisited) != unvisited)
+        {
+            return false;
+        }
+
+        // only last node of route may have less than two available neighbours
+        int deadEnds = 0;
+
+        for (Row rest = unvisited; rest; rest &= rest - 1)
+        {
+            const int index = BitMatrix::countTrailingZeros(rest);
+
+            if (BitMatrix::popcount(m_rows[index] & (unvisited | bit(end))) < 2 && ++deadEnds > 1)
+            {
+                return false;
+            }
+        }
+
+        for (Row next = m_rows[end] & unvisited; next; next &= next - 1)
+        {
+            const int index = BitMatrix::countTrailingZeros(next);
+
+            if (extendRoute(index, visited | bit(index)))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Depth first extension of path from node 0 ending in given node towards Hamilton circle
+     * @param end
+     * @param visited
+     * @return
+     */
+    constexpr bool extendCircle(int end, Row visited) const noexcept
+    {
+        const Row unvisited = getNodes() & ~visited;
+
+        if (!unvisited)
+        {
+            return hasEdge(end, 0);
+        }
+
+        if ((reachable(end, unvisited) & unvisited) != unvisited)
+        {
+            return false;
+        }
+
+        // every remaining node needs two neighbours to enter and leave it
+        const Row available = unvisited | bit(end) | bit(0);
+
+        for (Row rest = unvisited; rest; rest &= rest - 1)
+        {
+            if (BitMatrix::popcount(m_rows[BitMatrix::countTrailingZeros(rest)] & available) < 2)
+            {
+                return false;
+            }
+        }
+
+        for (Row next = m_rows[end] & unvisited; next; next &= next - 1)
+        {
+            const int index = BitMatrix::countTrailingZeros(next);
+
+            if (extendCircle(index, visited | bit(index)))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
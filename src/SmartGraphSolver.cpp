@@ -16,13 +16,36 @@
 /* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
 /*                                                                          */
 
+#include <algorithm>
 #include "SmartGraphSolver.hpp"
+#include "Graph.hpp"
+
+void SmartGraphSolver::reset() noexcept
+{
+    m_continuous = CacheState::UNKNOWN;
+    m_locallyContinuous = CacheState::UNKNOWN;
+    m_hasClaw = CacheState::UNKNOWN;
+    m_hamiltonRoute = CacheState::UNKNOWN;
+    m_hamiltonCircle = CacheState::UNKNOWN;
+    m_nodeContinuity = -1;
+    m_edgeContinuity = -1;
+    m_circumference = -1;
+    m_girth = -1;
+    m_chromaticNumber = -1;
+    m_componentCount = -1;
+    m_components.clear();
+    m_blocksKnown = false;
+    m_blocks.clear();
+    m_hamiltonRouteWitness.clear();
+    m_hamiltonCircleWitness.clear();
+    m_coloring.clear();
+}
 
 bool SmartGraphSolver::isContinuous() const noexcept
 {
     if (m_continuous == CacheState::UNKNOWN)
     {
-        const bool result = GraphSolver::isContinuous();
+        const bool result = m_componentCount == -1 ? GraphSolver::isContinuous() : m_componentCount <= 1;
         m_continuous = result ? CacheState::TRUE : CacheState::FALSE;
     }
 
@@ -50,7 +73,14 @@ int SmartGraphSolver::getNodeContinuity() const noexcept
             return m_nodeContinuity;
         }
 
-        m_nodeContinuity = 1; // TODO
+        // connected graph with cut vertex
+        if (m_blocksKnown && m_blocks.size() > 1)
+        {
+            m_nodeContinuity = 1;
+            return m_nodeContinuity;
+        }
+
+        m_nodeContinuity = m_edgeContinuity != -1 ? bfNodeContinuity(m_edgeContinuity) : bfNodeContinuity();
     }
 
     return m_nodeContinuity;
@@ -63,10 +93,25 @@ int SmartGraphSolver::getEdgeContinuity() const noexcept
         if (!isContinuous())
         {
             m_edgeContinuity = 0;
-            return m_nodeContinuity;
+            return m_edgeContinuity;
         }
 
-        m_edgeContinuity = 1; // TODO
+        // connected graph with bridge
+        if (m_blocksKnown && std::any_of(m_blocks.begin(), m_blocks.end(),
+                                         [](const std::vector<int>& block) { return block.size() == 2; }))
+        {
+            m_edgeContinuity = 1;
+            return m_edgeContinuity;
+        }
+
+        // node continuity bounds edge continuity from below, minimum degree from above
+        if (m_nodeContinuity == m_graph->getMinDegree())
+        {
+            m_edgeContinuity = m_nodeContinuity;
+            return m_edgeContinuity;
+        }
+
+        m_edgeContinuity = bfEdgeContinuity();
     }
 
     return m_edgeContinuity;
@@ -74,35 +119,165 @@ int SmartGraphSolver::getEdgeContinuity() const noexcept
 
 bool SmartGraphSolver::isKNodeContinuous(int k) const noexcept
 {
-    return getNodeContinuity() >= k;
+    if (m_nodeContinuity != -1)
+    {
+        return m_nodeContinuity >= k;
+    }
+
+    // node continuity never exceeds edge continuity
+    if (m_edgeContinuity != -1 && m_edgeContinuity < k)
+    {
+        return false;
+    }
+
+    if (k == 2 && isContinuous() && m_graph->getDegree() > 2)
+    {
+        return getBlocks().size() == 1;
+    }
+
+    return bfKNodeContinuity(k);
 }
 
 bool SmartGraphSolver::isKEdgeContinuous(int k) const noexcept
 {
-    return getEdgeContinuity() >= k;
+    if (m_edgeContinuity != -1)
+    {
+        return m_edgeContinuity >= k;
+    }
+
+    if (m_nodeContinuity != -1 && m_nodeContinuity >= k)
+    {
+        return true;
+    }
+
+    return bfKEdgeContinuity(k);
+}
+
+int SmartGraphSolver::getComponentCount() const noexcept
+{
+    if (m_componentCount == -1)
+    {
+        m_componentCount = bfComponents(m_components);
+        m_continuous = m_componentCount <= 1 ? CacheState::TRUE : CacheState::FALSE;
+    }
+
+    return m_componentCount;
+}
+
+std::vector<int> SmartGraphSolver::getComponents() const noexcept
+{
+    getComponentCount();
+
+    return m_components;
+}
+
+std::vector<std::vector<int>> SmartGraphSolver::getBlocks() const noexcept
+{
+    if (!m_blocksKnown)
+    {
+        bfBlocks(m_blocks);
+        m_blocksKnown = true;
+    }
+
+    return m_blocks;
+}
+
+std::vector<int> SmartGraphSolver::evaluateCyclicBlocks(const std::function<int(const Graph&)>& property) const
+{
+    getBlocks();
+
+    std::vector<std::vector<int>> cyclic;
+
+    for (auto& block : m_blocks)
+    {
+        if (block.size() >= 3)
+        {
+            cyclic.push_back(block);
+        }
+    }
+
+    return evaluateSubgraphs(cyclic, [&property](const Graph& block, int) {
+        return property(block);
+    });
 }
 
 int SmartGraphSolver::getCircumference() const noexcept
 {
     if (m_circumference == -1)
     {
+        // every circle lies within single block
+        if (getBlocks().size() > 1)
+        {
+            const std::vector<int> values = evaluateCyclicBlocks([](const Graph& block) {
+                return block.getCircumference();
+            });
+
+            m_circumference = values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+            return m_circumference;
+        }
+
         if (m_hamiltonCircle == CacheState::TRUE)
         {
-            m_circumference = GraphSolver::getCircumference();
+            m_circumference = m_graph->getDegree();
             return m_circumference;
         }
 
-        m_circumference = 0;// TODO
+        m_circumference = GraphSolver::getCircumference();
     }
 
     return m_circumference;
 }
 
+int SmartGraphSolver::getGirth() const noexcept
+{
+    if (m_girth == -1)
+    {
+        // every circle lies within single block
+        if (getBlocks().size() > 1)
+        {
+            const std::vector<int> values = evaluateCyclicBlocks([](const Graph& block) {
+                return block.getGirth();
+            });
+
+            // acyclic blocks have girth zero and do not count
+            m_girth = 0;
+
+            for (int value : values)
+            {
+                if (value > 0 && (m_girth == 0 || value < m_girth))
+                {
+                    m_girth = value;
+                }
+            }
+
+            return m_girth;
+        }
+
+        m_girth = GraphSolver::getGirth();
+    }
+
+    return m_girth;
+}
+
 bool SmartGraphSolver::hasClaw() const noexcept
 {
     if (m_hasClaw == CacheState::UNKNOWN)
     {
-        const bool result = bfHasClaw();
+        bool result = false;
+
+        if (getComponentCount() > 1)
+        {
+            const std::vector<int> values = evaluateComponents([](const Graph& component, int) {
+                return component.getDegree() >= 4 && component.hasClaw() ? 1 : 0;
+            }, false);
+
+            result = std::find(values.begin(), values.end(), 1) != values.end();
+        }
+        else
+        {
+            result = bfHasClaw();
+        }
+
         m_hasClaw = result ? CacheState::TRUE : CacheState::FALSE;
     }
 
@@ -129,6 +304,13 @@ bool SmartGraphSolver::hasHamiltonRoute() const noexcept
             return true;
         }
 
+        if (hamiltonObstruction(true))
+        {
+            m_hamiltonRoute = CacheState::FALSE;
+            m_hamiltonCircle = CacheState::FALSE;
+            return false;
+        }
+
         const bool result = GraphSolver::hasHamiltonRoute();
         m_hamiltonRoute = result ? CacheState::TRUE : CacheState::FALSE;
     }
@@ -138,22 +320,110 @@ bool SmartGraphSolver::hasHamiltonRoute() const noexcept
 
 bool SmartGraphSolver::hasHamiltonCircle() const noexcept
 {
-    if (m_hamiltonRoute == CacheState::UNKNOWN)
+    if (m_hamiltonCircle == CacheState::UNKNOWN)
     {
-        if (m_hamiltonRoute == CacheState::FALSE)
+        // circle cannot leave its block
+        if (m_hamiltonRoute == CacheState::FALSE || getBlocks().size() > 1 || hamiltonObstruction(false))
         {
-            m_hamiltonRoute = CacheState::FALSE;
+            m_hamiltonCircle = CacheState::FALSE;
             return false;
         }
 
         const bool result = GraphSolver::hasHamiltonCircle();
-        m_hamiltonRoute = result ? CacheState::TRUE : CacheState::FALSE;
+        m_hamiltonCircle = result ? CacheState::TRUE : CacheState::FALSE;
+
+        if (result)
+        {
+            m_hamiltonRoute = CacheState::TRUE;
+        }
     }
 
-    return m_hamiltonRoute == CacheState::TRUE;
+    return m_hamiltonCircle == CacheState::TRUE;
+}
+
+std::vector<int> SmartGraphSolver::getHamiltonRoute() const noexcept
+{
+    if (m_hamiltonRoute == CacheState::UNKNOWN && m_hamiltonCircleWitness.empty() && hamiltonObstruction(true))
+    {
+        m_hamiltonRoute = CacheState::FALSE;
+        m_hamiltonCircle = CacheState::FALSE;
+    }
+
+    if (m_hamiltonRouteWitness.empty() && m_hamiltonRoute != CacheState::FALSE)
+    {
+        // any circle opened at one place is a route
+        if (!m_hamiltonCircleWitness.empty())
+        {
+            m_hamiltonRouteWitness = m_hamiltonCircleWitness;
+        }
+        else
+        {
+            const bool result = bfHamiltonRoute(&m_hamiltonRouteWitness);
+            m_hamiltonRoute = result ? CacheState::TRUE : CacheState::FALSE;
+        }
+    }
+
+    return m_hamiltonRouteWitness;
+}
+
+std::vector<int> SmartGraphSolver::getHamiltonCircle() const noexcept
+{
+    if (m_hamiltonCircle == CacheState::UNKNOWN && (getBlocks().size() > 1 || hamiltonObstruction(false)))
+    {
+        m_hamiltonCircle = CacheState::FALSE;
+    }
+
+    if (m_hamiltonCircleWitness.empty() && m_hamiltonCircle != CacheState::FALSE && m_hamiltonRoute != CacheState::FALSE)
+    {
+        const bool result = bfHamiltonCircle(&m_hamiltonCircleWitness);
+        m_hamiltonCircle = result ? CacheState::TRUE : CacheState::FALSE;
+
+        if (result)
+        {
+            m_hamiltonRoute = CacheState::TRUE;
+        }
+    }
+
+    return m_hamiltonCircleWitness;
 }
 
 int SmartGraphSolver::getChromaticNumber() const noexcept
 {
-    return 0;
+    if (m_chromaticNumber == -1)
+    {
+        if (getComponentCount() > 1)
+        {
+            // components share no edge, so their colorings are merged as they are
+            std::vector<std::vector<int>> colorings(getComponentCount());
+            const std::vector<int> values = evaluateComponents([&colorings](const Graph& component, int label) {
+                colorings[label] = component.getColoring();
+                return component.getChromaticNumber();
+            }, false);
+
+            const std::vector<int> labels = getComponents();
+            std::vector<int> positions(colorings.size(), 0);
+            m_coloring.resize(m_graph->getDegree());
+
+            // component keeps order of nodes of graph
+            for (int i = 0; i < m_graph->getDegree(); i++)
+            {
+                m_coloring[i] = colorings[labels[i]][positions[labels[i]]++];
+            }
+
+            m_chromaticNumber = *std::max_element(values.begin(), values.end());
+            return m_chromaticNumber;
+        }
+
+        m_chromaticNumber = bfChromaticNumber(&m_coloring);
+    }
+
+    return m_chromaticNumber;
+}
+
+std::vector<int> SmartGraphSolver::getColoring() const noexcept
+{
+    // coloring is always found together with chromatic number
+    getChromaticNumber();
+
+    return m_coloring;
 }
@@ -34,6 +34,15 @@ protected:
     mutable int m_nodeContinuity = -1;
     mutable int m_edgeContinuity = -1;
     mutable int m_circumference = -1;
+    mutable int m_girth = -1;
+    mutable int m_chromaticNumber = -1;
+    mutable int m_componentCount = -1;
+    mutable std::vector<int> m_components;
+    mutable bool m_blocksKnown = false;
+    mutable std::vector<std::vector<int>> m_blocks;
+    mutable std::vector<int> m_hamiltonRouteWitness;
+    mutable std::vector<int> m_hamiltonCircleWitness;
+    mutable std::vector<int> m_coloring;
 
 public:
 
@@ -41,6 +50,10 @@ public:
         GraphSolver(graph)
     {}
 
+    /**
+     * Discards all cached results
+     */
+    void reset() noexcept override;
 
 public:
 
@@ -86,6 +99,33 @@ public:
      */
     bool isKEdgeContinuous(int k) const noexcept override;
 
+    /**
+     * Returns number of connected components
+     * @return
+     */
+    int getComponentCount() const noexcept override;
+
+    /**
+     * Returns label of connected component of every node
+     * @return
+     */
+    std::vector<int> getComponents() const noexcept override;
+
+    /**
+     * Returns biconnected blocks, each as ascending list of its nodes
+     * @return
+     */
+    std::vector<std::vector<int>> getBlocks() const noexcept override;
+
+protected:
+
+    /**
+     * Evaluates property on blocks of at least three nodes, the only ones which contain circles
+     * @param property
+     * @return
+     */
+    std::vector<int> evaluateCyclicBlocks(const std::function<int(const Graph&)>& property) const;
+
 public:
 
     /*
@@ -98,6 +138,12 @@ public:
      */
     int getCircumference() const noexcept override;
 
+    /**
+     * Returns length of shortest circle in graph
+     * @return
+     */
+    int getGirth() const noexcept override;
+
     /**
      * Returns whether graph has K13 as subgraph
      * @return
@@ -134,6 +180,18 @@ public:
      */
     bool hasHamiltonCircle() const noexcept override;
 
+    /**
+     * Returns order of nodes of some Hamilton route, empty if there is none
+     * @return
+     */
+    std::vector<int> getHamiltonRoute() const noexcept override;
+
+    /**
+     * Returns order of nodes of some Hamilton circle, empty if there is none
+     * @return
+     */
+    std::vector<int> getHamiltonCircle() const noexcept override;
+
 public:
 
     /*
@@ -145,4 +203,10 @@ public:
      * @return
      */
     int getChromaticNumber() const noexcept override;
+
+    /**
+     * Returns color of every node in minimal coloring
+     * @return
+     */
+    std::vector<int> getColoring() const noexcept override;
 };
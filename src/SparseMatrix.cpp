@@ -0,0 +1,269 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#include <algorithm>
+#include "SparseMatrix.hpp"
+
+SparseMatrix::SparseMatrix(int size, const std::vector<std::pair<int, int>>& edges, std::pmr::memory_resource* resource) :
+    m_size(size),
+    m_offsets(size + 1, 0, resource),
+    m_targets(resource)
+{
+    for (auto& edge : edges)
+    {
+        if (edge.first != edge.second)
+        {
+            m_offsets[edge.first + 1]++;
+            m_offsets[edge.second + 1]++;
+        }
+    }
+
+    for (int i = 0; i < m_size; i++)
+    {
+        m_offsets[i + 1] += m_offsets[i];
+    }
+
+    m_targets.resize(m_offsets[m_size]);
+    std::vector<int> position(m_offsets.begin(), m_offsets.end() - 1);
+
+    for (auto& edge : edges)
+    {
+        if (edge.first != edge.second)
+        {
+            m_targets[position[edge.first]++] = edge.second;
+            m_targets[position[edge.second]++] = edge.first;
+        }
+    }
+
+    // sort rows and drop duplicate entries, compacting storage in place
+    int write = 0;
+
+    for (int i = 0; i < m_size; i++)
+    {
+        const int begin = m_offsets[i];
+        const int end = m_offsets[i + 1];
+
+        std::sort(m_targets.begin() + begin, m_targets.begin() + end);
+        m_offsets[i] = write;
+
+        for (int j = begin; j < end; j++)
+        {
+            if (j == begin || m_targets[j] != m_targets[j - 1])
+            {
+                m_targets[write++] = m_targets[j];
+            }
+        }
+    }
+
+    m_offsets[m_size] = write;
+    m_targets.resize(write);
+    m_targets.shrink_to_fit();
+}
+
+SparseMatrix::SparseMatrix(const BitMatrix& matrix, std::pmr::memory_resource* resource) :
+    m_size(matrix.size()),
+    m_offsets(matrix.size() + 1, 0, resource),
+    m_targets(resource)
+{
+    for (int i = 0; i < m_size; i++)
+    {
+        m_offsets[i + 1] = m_offsets[i] + matrix.rowCount(i);
+    }
+
+    m_targets.reserve(m_offsets[m_size]);
+
+    for (int i = 0; i < m_size; i++)
+    {
+        const BitMatrix::Word* row = matrix.row(i);
+
+        for (int j = 0; j < matrix.words(); j++)
+        {
+            BitMatrix::Word word = row[j];
+
+            while (word)
+            {
+                m_targets.push_back(j * BitMatrix::WORD_BITS + BitMatrix::countTrailingZeros(word));
+                word &= word - 1;
+            }
+        }
+    }
+}
+
+bool SparseMatrix::get(int rowIndex, int colIndex) const noexcept
+{
+    return std::binary_search(rowBegin(rowIndex), rowEnd(rowIndex), colIndex);
+}
+
+void SparseMatrix::set(int rowIndex, int colIndex)
+{
+    const int* position = std::lower_bound(rowBegin(rowIndex), rowEnd(rowIndex), colIndex);
+
+    if (position != rowEnd(rowIndex) && *position == colIndex)
+    {
+        return;
+    }
+
+    m_targets.insert(m_targets.begin() + (position - m_targets.data()), colIndex);
+
+    for (int i = rowIndex + 1; i <= m_size; i++)
+    {
+        m_offsets[i]++;
+    }
+}
+
+void SparseMatrix::reset(int rowIndex, int colIndex)
+{
+    const int* position = std::lower_bound(rowBegin(rowIndex), rowEnd(rowIndex), colIndex);
+
+    if (position == rowEnd(rowIndex) || *position != colIndex)
+    {
+        return;
+    }
+
+    m_targets.erase(m_targets.begin() + (position - m_targets.data()));
+
+    for (int i = rowIndex + 1; i <= m_size; i++)
+    {
+        m_offsets[i]--;
+    }
+}
+
+void SparseMatrix::update(const std::vector<std::pair<int, int>>& added, const std::vector<std::pair<int, int>>& removed)
+{
+    std::vector<std::pair<int, int>> sortedRemoved;
+    sortedRemoved.reserve(removed.size());
+
+    for (auto& edge : removed)
+    {
+        sortedRemoved.emplace_back(std::min(edge.first, edge.second), std::max(edge.first, edge.second));
+    }
+
+    std::sort(sortedRemoved.begin(), sortedRemoved.end());
+
+    std::vector<std::pair<int, int>> edges(added);
+    edges.reserve(m_targets.size() / 2 + added.size());
+
+    for (int i = 0; i < m_size; i++)
+    {
+        for (const int* j = std::upper_bound(rowBegin(i), rowEnd(i), i); j != rowEnd(i); j++)
+        {
+            if (!std::binary_search(sortedRemoved.begin(), sortedRemoved.end(), std::make_pair(i, *j)))
+            {
+                edges.emplace_back(i, *j);
+            }
+        }
+    }
+
+    *this = SparseMatrix(m_size, edges, resource());
+}
+
+void SparseMatrix::addNode()
+{
+    m_offsets.push_back(m_offsets.back());
+    m_size++;
+}
+
+void SparseMatrix::removeNode(int index)
+{
+    int write = 0;
+
+    for (int i = 0; i < m_size; i++)
+    {
+        const int begin = m_offsets[i];
+        const int end = m_offsets[i + 1];
+        m_offsets[i] = write;
+
+        if (i == index)
+        {
+            continue;
+        }
+
+        for (int j = begin; j < end; j++)
+        {
+            if (m_targets[j] != index)
+            {
+                m_targets[write++] = m_targets[j] > index ? m_targets[j] - 1 : m_targets[j];
+            }
+        }
+    }
+
+    m_offsets[m_size] = write;
+    m_offsets.erase(m_offsets.begin() + index);
+    m_targets.resize(write);
+    m_size--;
+}
+
+void SparseMatrix::removeNodes(const std::vector<int>& indices)
+{
+    std::vector<int> position(m_size, -1);
+    int size = 0;
+
+    for (int i = 0, next = 0; i < m_size; i++)
+    {
+        if (next < static_cast<int>(indices.size()) && indices[next] == i)
+        {
+            next++;
+            continue;
+        }
+
+        position[i] = size++;
+    }
+
+    int write = 0;
+
+    for (int i = 0; i < m_size; i++)
+    {
+        const int begin = m_offsets[i];
+        const int end = m_offsets[i + 1];
+
+        if (position[i] == -1)
+        {
+            continue;
+        }
+
+        m_offsets[position[i]] = write;
+
+        for (int j = begin; j < end; j++)
+        {
+            if (position[m_targets[j]] != -1)
+            {
+                m_targets[write++] = position[m_targets[j]];
+            }
+        }
+    }
+
+    m_offsets[size] = write;
+    m_offsets.resize(size + 1);
+    m_targets.resize(write);
+    m_size = size;
+}
+
+BitMatrix SparseMatrix::toBitMatrix(std::pmr::memory_resource* resource) const
+{
+    BitMatrix matrix(m_size, resource);
+
+    for (int i = 0; i < m_size; i++)
+    {
+        for (const int* j = rowBegin(i); j != rowEnd(i); j++)
+        {
+            matrix.set(i, *j);
+        }
+    }
+
+    return matrix;
+}
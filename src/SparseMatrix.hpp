@@ -0,0 +1,209 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#pragma once
+
+#include <memory_resource>
+#include <utility>
+#include <vector>
+#include "BitMatrix.hpp"
+
+class SparseMatrix
+{
+
+protected:
+
+    int m_size;
+    std::pmr::vector<int> m_offsets;
+    std::pmr::vector<int> m_targets;
+
+public:
+
+    /**
+     * Constructor of empty matrix
+     * @param resource
+     */
+    explicit SparseMatrix(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+        m_size(0),
+        m_offsets(1, 0, resource),
+        m_targets(resource)
+    {}
+
+    /**
+     * Constructor by list of undirected edges, loops and duplicates are ignored
+     * @param size
+     * @param edges
+     * @param resource
+     */
+    SparseMatrix(int size, const std::vector<std::pair<int, int>>& edges,
+                 std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /**
+     * Constructor by bit matrix
+     * @param matrix
+     * @param resource
+     */
+    explicit SparseMatrix(const BitMatrix& matrix, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /**
+     * Copy constructor placing copy into given memory resource
+     * @param other
+     * @param resource
+     */
+    SparseMatrix(const SparseMatrix& other, std::pmr::memory_resource* resource) :
+        m_size(other.m_size),
+        m_offsets(other.m_offsets, resource),
+        m_targets(other.m_targets, resource)
+    {}
+
+    /**
+     * Move constructor placing result into given memory resource, storage is copied if resources differ
+     * @param other
+     * @param resource
+     */
+    SparseMatrix(SparseMatrix&& other, std::pmr::memory_resource* resource) :
+        m_size(other.m_size),
+        m_offsets(std::move(other.m_offsets), resource),
+        m_targets(std::move(other.m_targets), resource)
+    {}
+
+    SparseMatrix(const SparseMatrix& other) = default;
+    SparseMatrix(SparseMatrix&& other) noexcept = default;
+    SparseMatrix& operator=(const SparseMatrix& other) = default;
+    SparseMatrix& operator=(SparseMatrix&& other) = default;
+
+public:
+
+    /**
+     * Returns number of memory bytes needed by compressed representation
+     * @param size
+     * @param edgeCount
+     * @return
+     */
+    static std::size_t memoryUsage(int size, std::size_t edgeCount) noexcept
+    {
+        return (static_cast<std::size_t>(size) + 1 + 2 * edgeCount) * sizeof(int);
+    }
+
+public:
+
+    /**
+     * Returns memory resource used for storage
+     * @return
+     */
+    std::pmr::memory_resource* resource() const noexcept
+    {
+        return m_offsets.get_allocator().resource();
+    }
+
+    /**
+     * Returns number of rows (and columns)
+     * @return
+     */
+    int size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * Returns pointer to first (lowest) column index stored in given row
+     * @param index
+     * @return
+     */
+    const int* rowBegin(int index) const noexcept
+    {
+        return m_targets.data() + m_offsets[index];
+    }
+
+    /**
+     * Returns pointer past last column index stored in given row
+     * @param index
+     * @return
+     */
+    const int* rowEnd(int index) const noexcept
+    {
+        return m_targets.data() + m_offsets[index + 1];
+    }
+
+    /**
+     * Returns number of set entries in given row
+     * @param index
+     * @return
+     */
+    int rowCount(int index) const noexcept
+    {
+        return m_offsets[index + 1] - m_offsets[index];
+    }
+
+public:
+
+    /**
+     * Returns entry at given position
+     * @param rowIndex
+     * @param colIndex
+     * @return
+     */
+    bool get(int rowIndex, int colIndex) const noexcept;
+
+    /**
+     * Sets entry at given position
+     * @param rowIndex
+     * @param colIndex
+     */
+    void set(int rowIndex, int colIndex);
+
+    /**
+     * Clears entry at given position
+     * @param rowIndex
+     * @param colIndex
+     */
+    void reset(int rowIndex, int colIndex);
+
+    /**
+     * Sets and clears given symmetric entries in single rebuild
+     * @param added
+     * @param removed
+     */
+    void update(const std::vector<std::pair<int, int>>& added, const std::vector<std::pair<int, int>>& removed);
+
+public:
+
+    /**
+     * Appends empty row and column
+     */
+    void addNode();
+
+    /**
+     * Removes row and column at given index
+     * @param index
+     */
+    void removeNode(int index);
+
+    /**
+     * Removes rows and columns at given sorted indices at once
+     * @param indices
+     */
+    void removeNodes(const std::vector<int>& indices);
+
+    /**
+     * Returns dense representation
+     * @param resource
+     * @return
+     */
+    BitMatrix toBitMatrix(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+};
@@ -0,0 +1,139 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include "ThreadPool.hpp"
+
+ThreadPool::ThreadPool(int workerCount)
+{
+    m_threads.reserve(workerCount);
+
+    for (int i = 0; i < workerCount; i++)
+    {
+        m_threads.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool(std::max(1, static_cast<int>(std::thread::hardware_concurrency())) - 1);
+
+    return pool;
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& function)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    if (m_threads.empty() || count == 1)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            function(i);
+        }
+
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<int> next {0};
+        std::atomic<int> done {0};
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    auto state = std::make_shared<State>();
+
+    // helpers starting after all indices were taken exit without touching function
+    auto loop = [state, &function, count]()
+    {
+        int index;
+
+        while ((index = state->next++) < count)
+        {
+            function(index);
+
+            if (++state->done == count)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    const int helpers = std::min(static_cast<int>(m_threads.size()), count - 1);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (int i = 0; i < helpers; i++)
+        {
+            m_tasks.emplace_back(loop);
+        }
+    }
+
+    m_condition.notify_all();
+    loop();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state, count]() { return state->done == count; });
+}
+
+void ThreadPool::work()
+{
+    while (true)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+
+            if (m_stopping && m_tasks.empty())
+            {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        task();
+    }
+}
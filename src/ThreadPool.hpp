@@ -0,0 +1,86 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of worker threads executing parallel loops
+ * Calling thread takes part in every loop, so nested loops never wait for a free worker
+ */
+class ThreadPool
+{
+
+protected:
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping = false;
+
+public:
+
+    /**
+     * Constructor of pool with given number of worker threads
+     * @param workerCount
+     */
+    explicit ThreadPool(int workerCount);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+public:
+
+    /**
+     * Returns shared pool sized to hardware concurrency
+     * @return
+     */
+    static ThreadPool& instance();
+
+    /**
+     * Returns number of threads taking part in parallel loop, including calling thread
+     * @return
+     */
+    int getThreadCount() const noexcept
+    {
+        return static_cast<int>(m_threads.size()) + 1;
+    }
+
+    /**
+     * Calls function for each index in [0, count) in parallel and waits for all calls to finish
+     * @param count
+     * @param function
+     */
+    void parallelFor(int count, const std::function<void(int)>& function);
+
+protected:
+
+    /**
+     * Loop of single worker thread
+     */
+    void work();
+};
@@ -0,0 +1,712 @@
+/*                                                                          */
+/* Copyright (c) 2018 Václav Pelíšek (info@peldax.com)                      */
+/* This file is part of Forester.                                           */
+/*                                                                          */
+/* Forester is free software: you can redistribute it and/or modify         */
+/* it under the terms of the GNU General Public License as published by     */
+/* the Free Software Foundation, either version 3 of the License, or        */
+/* (at your option) any later version.                                      */
+/*                                                                          */
+/* Forester is distributed in the hope that it will be useful,              */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            */
+/* GNU General Public License for more details.                             */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License        */
+/* along with Forester.  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                          */
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CircumferenceSearch.hpp"
+#include "ColoringSearch.hpp"
+#include "Graph.hpp"
+#include "HamiltonDP.hpp"
+#include "HamiltonSearch.hpp"
+#include "SmallGraph.hpp"
+
+/**
+ * Cross check of exact graph algorithms against brute force
+ * Every labelled graph up to EXHAUSTIVE_DEGREE nodes is checked, larger ones are sampled with fixed seed,
+ * known graph families are checked against their known properties
+ * Subset table is filled directly only for family members up to FAMILY_TABLE_DEGREE nodes to keep the run short
+ */
+
+using Matrix = std::vector<std::vector<bool>>;
+
+static constexpr int EXHAUSTIVE_DEGREE = 6;
+static constexpr int SAMPLED_DEGREE = 8;
+static constexpr int SAMPLES = 1000;
+static constexpr int FAMILY_TABLE_DEGREE = 20;
+
+static int checks = 0;
+static int failures = 0;
+
+/**
+ * Counts check and reports it when it fails
+ * @param condition
+ * @param name
+ */
+static void expect(bool condition, const std::string& name)
+{
+    checks++;
+
+    if (!condition)
+    {
+        failures++;
+        std::cerr << "FAILED: " << name << std::endl;
+    }
+}
+
+/**
+ * Returns adjacency matrix of graph given by edges
+ * @param degree
+ * @param edges
+ * @return
+ */
+static Matrix toMatrix(int degree, const std::vector<std::pair<int, int>>& edges)
+{
+    Matrix matrix(degree, std::vector<bool>(degree, false));
+
+    for (const auto& edge : edges)
+    {
+        matrix[edge.first][edge.second] = true;
+        matrix[edge.second][edge.first] = true;
+    }
+
+    return matrix;
+}
+
+/**
+ * Returns edges of given adjacency matrix
+ * @param matrix
+ * @return
+ */
+static std::vector<std::pair<int, int>> toEdges(const Matrix& matrix)
+{
+    std::vector<std::pair<int, int>> edges;
+
+    for (int i = 0; i < static_cast<int>(matrix.size()); i++)
+    {
+        for (int j = i + 1; j < static_cast<int>(matrix.size()); j++)
+        {
+            if (matrix[i][j])
+            {
+                edges.emplace_back(i, j);
+            }
+        }
+    }
+
+    return edges;
+}
+
+/**
+ * Brute force Hamilton check over all orders of nodes
+ * @param matrix
+ * @param circle
+ * @return
+ */
+static bool bruteHamilton(const Matrix& matrix, bool circle)
+{
+    const int degree = static_cast<int>(matrix.size());
+    std::vector<int> order(degree);
+    std::iota(order.begin(), order.end(), 0);
+
+    if (degree == 0 || (circle && degree < 3))
+    {
+        return false;
+    }
+
+    do
+    {
+        bool valid = true;
+
+        for (int i = 0; i + 1 < degree && valid; i++)
+        {
+            valid = matrix[order[i]][order[i + 1]];
+        }
+
+        if (valid && (!circle || matrix[order[degree - 1]][order[0]]))
+        {
+            return true;
+        }
+    }
+    while (std::next_permutation(order.begin() + (circle ? 1 : 0), order.end()));
+
+    return false;
+}
+
+/**
+ * Returns whether nodes outside of given removed set are connected
+ * @param matrix
+ * @param removed
+ * @return
+ */
+static bool bruteConnected(const Matrix& matrix, long long removed)
+{
+    const int degree = static_cast<int>(matrix.size());
+    std::vector<int> stack;
+    long long reached = removed;
+
+    for (int i = 0; i < degree && stack.empty(); i++)
+    {
+        if (!((removed >> i) & 1))
+        {
+            stack.push_back(i);
+            reached |= 1LL << i;
+        }
+    }
+
+    while (!stack.empty())
+    {
+        const int node = stack.back();
+        stack.pop_back();
+
+        for (int i = 0; i < degree; i++)
+        {
+            if (matrix[node][i] && !((reached >> i) & 1))
+            {
+                reached |= 1LL << i;
+                stack.push_back(i);
+            }
+        }
+    }
+
+    return reached == (1LL << degree) - 1;
+}
+
+/**
+ * Brute force node continuity as size of smallest set whose removal disconnects graph, n - 1 for complete graph
+ * @param matrix
+ * @return
+ */
+static int bruteNodeContinuity(const Matrix& matrix)
+{
+    const int degree = static_cast<int>(matrix.size());
+    int best = std::max(degree - 1, 0);
+
+    for (long long removed = 0; removed < (1LL << degree); removed++)
+    {
+        const int size = BitMatrix::popcount(removed);
+
+        if (size < best && size <= degree - 2 && !bruteConnected(matrix, removed))
+        {
+            best = size;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * Compares node continuity and its threshold checks with brute force
+ * @param matrix
+ * @param graph
+ * @param name
+ */
+static void checkNodeContinuity(const Matrix& matrix, const Graph& graph, const std::string& name)
+{
+    const int continuity = bruteNodeContinuity(matrix);
+
+    expect(graph.getNodeContinuity() == continuity, name + ": node continuity");
+
+    for (int k = 0; k <= continuity + 1; k++)
+    {
+        expect(graph.isKNodeContinuous(k) == (k <= continuity), name + ": " + std::to_string(k) + " node continuity");
+    }
+}
+
+/**
+ * Extends path ending in given node by nodes above its start and records lengths of circles closed to start
+ * @param matrix
+ * @param path
+ * @param visited
+ * @param shortest
+ * @param longest
+ */
+static void extendCircles(const Matrix& matrix, std::vector<int>& path, std::vector<bool>& visited, int& shortest,
+                          int& longest)
+{
+    const int degree = static_cast<int>(matrix.size());
+    const int start = path.front();
+    const int end = path.back();
+    const int length = static_cast<int>(path.size());
+
+    if (length >= 3 && matrix[end][start])
+    {
+        shortest = shortest == 0 ? length : std::min(shortest, length);
+        longest = std::max(longest, length);
+    }
+
+    for (int i = start + 1; i < degree; i++)
+    {
+        if (matrix[end][i] && !visited[i])
+        {
+            visited[i] = true;
+            path.push_back(i);
+            extendCircles(matrix, path, visited, shortest, longest);
+            path.pop_back();
+            visited[i] = false;
+        }
+    }
+}
+
+/**
+ * Brute force girth and circumference over all circles, both are zero for graph without circle
+ * @param matrix
+ * @param shortest
+ * @param longest
+ */
+static void bruteCircles(const Matrix& matrix, int& shortest, int& longest)
+{
+    const int degree = static_cast<int>(matrix.size());
+    std::vector<bool> visited(degree, false);
+    std::vector<int> path;
+
+    shortest = 0;
+    longest = 0;
+
+    for (int start = 0; start < degree; start++)
+    {
+        path.assign(1, start);
+        extendCircles(matrix, path, visited, shortest, longest);
+    }
+}
+
+/**
+ * Compares girth and circumference with brute force
+ * @param matrix
+ * @param graph
+ * @param name
+ */
+static void checkCircles(const Matrix& matrix, const Graph& graph, const std::string& name)
+{
+    int shortest = 0;
+    int longest = 0;
+    bruteCircles(matrix, shortest, longest);
+
+    expect(graph.getGirth() == shortest, name + ": girth");
+    expect(graph.getCircumference() == longest, name + ": circumference");
+    expect(CircumferenceSearch(graph).find() == longest, name + ": circumference search");
+}
+
+/**
+ * Returns whether nodes from given one on can be colored by given number of colors
+ * @param matrix
+ * @param colors
+ * @param node
+ * @param coloring
+ * @return
+ */
+static bool extendColoring(const Matrix& matrix, int colors, int node, std::vector<int>& coloring)
+{
+    if (node == static_cast<int>(matrix.size()))
+    {
+        return true;
+    }
+
+    for (int color = 0; color < colors; color++)
+    {
+        bool free = true;
+
+        for (int i = 0; i < node && free; i++)
+        {
+            free = !matrix[node][i] || coloring[i] != color;
+        }
+
+        if (free)
+        {
+            coloring[node] = color;
+
+            if (extendColoring(matrix, colors, node + 1, coloring))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Brute force chromatic number as smallest number of colors which suffices
+ * @param matrix
+ * @return
+ */
+static int bruteChromaticNumber(const Matrix& matrix)
+{
+    std::vector<int> coloring(matrix.size(), 0);
+    int colors = 0;
+
+    while (!extendColoring(matrix, colors, 0, coloring))
+    {
+        colors++;
+    }
+
+    return colors;
+}
+
+/**
+ * Returns whether coloring is proper and uses colors below given count only
+ * @param matrix
+ * @param coloring
+ * @param colors
+ * @return
+ */
+static bool isColoring(const Matrix& matrix, const std::vector<int>& coloring, int colors)
+{
+    if (coloring.size() != matrix.size())
+    {
+        return false;
+    }
+
+    for (int i = 0; i < static_cast<int>(matrix.size()); i++)
+    {
+        if (coloring[i] < 0 || coloring[i] >= colors)
+        {
+            return false;
+        }
+
+        for (int j = i + 1; j < static_cast<int>(matrix.size()); j++)
+        {
+            if (matrix[i][j] && coloring[i] == coloring[j])
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Compares chromatic number and coloring with brute force
+ * @param matrix
+ * @param graph
+ * @param name
+ */
+static void checkColoring(const Matrix& matrix, const Graph& graph, const std::string& name)
+{
+    const int chromaticNumber = bruteChromaticNumber(matrix);
+    std::vector<int> coloring;
+
+    expect(graph.getChromaticNumber() == chromaticNumber, name + ": chromatic number");
+    expect(isColoring(matrix, graph.getColoring(), chromaticNumber), name + ": coloring");
+    expect(ColoringSearch(graph).find(coloring) == chromaticNumber, name + ": coloring search");
+    expect(isColoring(matrix, coloring, chromaticNumber), name + ": coloring search witness");
+}
+
+/**
+ * Compares Hamilton checks and their witnesses with brute force
+ * @param matrix
+ * @param graph
+ * @param name
+ */
+static void checkHamilton(const Matrix& matrix, const Graph& graph, const std::string& name)
+{
+    const bool route = bruteHamilton(matrix, false);
+    const bool circle = bruteHamilton(matrix, true);
+    std::vector<int> witness;
+
+    expect(graph.hasHamiltonRoute() == route, name + ": Hamilton route");
+    expect(graph.hasHamiltonCircle() == circle, name + ": Hamilton circle");
+    expect(graph.getHamiltonRoute().empty() != route, name + ": Hamilton route witness");
+    expect(graph.getHamiltonCircle().empty() != circle, name + ": Hamilton circle witness");
+
+    if (graph.getDegree() <= HamiltonDP::maxRouteDegree())
+    {
+        const HamiltonDP dp(graph);
+
+        expect((dp.hasHamiltonRoute(&witness) == SearchResult::FOUND) == route, name + ": Held-Karp route");
+        expect(!route || graph.isHamiltonRoute(witness), name + ": Held-Karp route witness");
+        expect((dp.hasHamiltonCircle(&witness) == SearchResult::FOUND) == circle, name + ": Held-Karp circle");
+        expect(!circle || graph.isHamiltonCircle(witness), name + ": Held-Karp circle witness");
+    }
+
+    expect((HamiltonSearch(graph, true).find(witness) == SearchResult::FOUND) == route, name + ": search route");
+    expect(!route || graph.isHamiltonRoute(witness), name + ": search route witness");
+    expect((HamiltonSearch(graph, false).find(witness) == SearchResult::FOUND) == circle, name + ": search circle");
+    expect(!circle || graph.isHamiltonCircle(witness), name + ": search circle witness");
+
+    if (graph.getDegree() <= SmallGraph<BitMatrix::WORD_BITS>::capacity())
+    {
+        const SmallGraph<BitMatrix::WORD_BITS> small(graph);
+
+        expect(small.hasHamiltonRoute() == route, name + ": small graph route");
+        expect(small.hasHamiltonCircle() == circle, name + ": small graph circle");
+    }
+}
+
+/**
+ * Runs all brute force comparisons on given graph in both representations
+ * @param matrix
+ * @param name
+ */
+static void checkAll(const Matrix& matrix, const std::string& name)
+{
+    for (GraphRepresentation representation : {GraphRepresentation::DENSE, GraphRepresentation::SPARSE})
+    {
+        const Graph graph(static_cast<int>(matrix.size()), toEdges(matrix), representation);
+        const std::string label = name + (representation == GraphRepresentation::DENSE ? " dense" : " sparse");
+
+        checkHamilton(matrix, graph, label);
+        checkNodeContinuity(matrix, graph, label);
+        checkCircles(matrix, graph, label);
+        checkColoring(matrix, graph, label);
+    }
+}
+
+/**
+ * Calls function for every labelled graph with given number of nodes
+ * @param degree
+ * @param function
+ */
+static void forEachGraph(int degree, const std::function<void(const Matrix&)>& function)
+{
+    const int pairs = degree * (degree - 1) / 2;
+
+    for (long long mask = 0; mask < (1LL << pairs); mask++)
+    {
+        Matrix matrix(degree, std::vector<bool>(degree, false));
+        int bit = 0;
+
+        for (int i = 0; i < degree; i++)
+        {
+            for (int j = i + 1; j < degree; j++, bit++)
+            {
+                matrix[i][j] = matrix[j][i] = (mask >> bit) & 1;
+            }
+        }
+
+        function(matrix);
+    }
+}
+
+/**
+ * Returns complete graph
+ * @param degree
+ * @return
+ */
+static Matrix complete(int degree)
+{
+    Matrix matrix(degree, std::vector<bool>(degree, true));
+
+    for (int i = 0; i < degree; i++)
+    {
+        matrix[i][i] = false;
+    }
+
+    return matrix;
+}
+
+/**
+ * Returns circle graph
+ * @param degree
+ * @return
+ */
+static Matrix cycle(int degree)
+{
+    std::vector<std::pair<int, int>> edges;
+
+    for (int i = 0; i < degree; i++)
+    {
+        edges.emplace_back(i, (i + 1) % degree);
+    }
+
+    return toMatrix(degree, edges);
+}
+
+/**
+ * Returns complete bipartite graph
+ * @param left
+ * @param right
+ * @return
+ */
+static Matrix completeBipartite(int left, int right)
+{
+    std::vector<std::pair<int, int>> edges;
+
+    for (int i = 0; i < left; i++)
+    {
+        for (int j = 0; j < right; j++)
+        {
+            edges.emplace_back(i, left + j);
+        }
+    }
+
+    return toMatrix(left + right, edges);
+}
+
+/**
+ * Returns two cliques of given size sharing given number of nodes, the shared nodes form the only minimal separator
+ * @param size
+ * @param shared
+ * @return
+ */
+static Matrix sharedCliques(int size, int shared)
+{
+    const int degree = 2 * size - shared;
+    Matrix matrix(degree, std::vector<bool>(degree, false));
+
+    for (int i = 0; i < degree; i++)
+    {
+        for (int j = i + 1; j < degree; j++)
+        {
+            matrix[i][j] = matrix[j][i] = j < size || i >= size - shared;
+        }
+    }
+
+    return matrix;
+}
+
+/**
+ * Returns Petersen graph, girth 5, circumference 9, chromatic number 3, node continuity 3, not Hamiltonian
+ * @return
+ */
+static Matrix petersen()
+{
+    std::vector<std::pair<int, int>> edges;
+
+    // outer pentagon, spokes and inner pentagram
+    for (int i = 0; i < 5; i++)
+    {
+        edges.emplace_back(i, (i + 1) % 5);
+        edges.emplace_back(i, i + 5);
+        edges.emplace_back(i + 5, (i + 2) % 5 + 5);
+    }
+
+    return toMatrix(10, edges);
+}
+
+/**
+ * Returns Grötzsch graph, triangle free with chromatic number 4, Hamiltonian
+ * @return
+ */
+static Matrix grotzsch()
+{
+    std::vector<std::pair<int, int>> edges;
+
+    // Mycielskian of pentagon: pentagon, shadow of every node joined to its neighbours, apex joined to shadows
+    for (int i = 0; i < 5; i++)
+    {
+        edges.emplace_back(i, (i + 1) % 5);
+        edges.emplace_back(i + 5, (i + 1) % 5);
+        edges.emplace_back(i + 5, (i + 4) % 5);
+        edges.emplace_back(i + 5, 10);
+    }
+
+    return toMatrix(11, edges);
+}
+
+/**
+ * Known properties of graph family member
+ */
+struct Expected
+{
+    std::string name;
+    Matrix matrix;
+    bool route;
+    bool circle;
+    int nodeContinuity;
+    int girth;
+    int circumference;
+    int chromaticNumber;
+};
+
+int main()
+{
+    for (int degree = 1; degree <= EXHAUSTIVE_DEGREE; degree++)
+    {
+        forEachGraph(degree, [degree](const Matrix& matrix)
+        {
+            checkAll(matrix, "exhaustive " + std::to_string(degree));
+        });
+    }
+
+    std::mt19937 random(2018);
+
+    for (int degree = EXHAUSTIVE_DEGREE + 1; degree <= SAMPLED_DEGREE; degree++)
+    {
+        for (int sample = 0; sample < SAMPLES; sample++)
+        {
+            // edge probability varies between samples to cover sparse and dense graphs
+            const unsigned density = random() % 9 + 1;
+            Matrix matrix(degree, std::vector<bool>(degree, false));
+
+            for (int i = 0; i < degree; i++)
+            {
+                for (int j = i + 1; j < degree; j++)
+                {
+                    matrix[i][j] = matrix[j][i] = random() % 10 < density;
+                }
+            }
+
+            checkAll(matrix, "sampled " + std::to_string(degree) + " #" + std::to_string(sample));
+        }
+    }
+
+    std::vector<Expected> families;
+    families.push_back({"Petersen", petersen(), true, false, 3, 5, 9, 3});
+    families.push_back({"Grotzsch", grotzsch(), true, true, 3, 4, 11, 4});
+
+    for (int degree = 1; degree <= 12; degree++)
+    {
+        families.push_back({"K" + std::to_string(degree), complete(degree), true, degree >= 3, degree - 1,
+                            degree >= 3 ? 3 : 0, degree >= 3 ? degree : 0, degree});
+    }
+
+    for (int shared = 1; shared <= 5; shared++)
+    {
+        families.push_back({"shared cliques " + std::to_string(shared), sharedCliques(8, shared), true, shared >= 2,
+                            shared, 3, shared >= 2 ? 16 - shared : 8, 8});
+    }
+
+    for (int degree = 3; degree <= 24; degree++)
+    {
+        families.push_back({"C" + std::to_string(degree), cycle(degree), true, true, 2, degree, degree,
+                            degree % 2 == 0 ? 2 : 3});
+    }
+
+    for (int left = 1; left <= 11; left++)
+    {
+        for (int right = left; right <= 11 && left + right <= 22; right++)
+        {
+            families.push_back({"K" + std::to_string(left) + "," + std::to_string(right), completeBipartite(left, right),
+                                right - left <= 1, left == right && left >= 2, left, left >= 2 ? 4 : 0,
+                                left >= 2 ? 2 * left : 0, 2});
+        }
+    }
+
+    for (const Expected& family : families)
+    {
+        const Graph graph(family.matrix);
+
+        expect(graph.hasHamiltonRoute() == family.route, family.name + ": Hamilton route");
+        expect(graph.hasHamiltonCircle() == family.circle, family.name + ": Hamilton circle");
+        expect(graph.getNodeContinuity() == family.nodeContinuity, family.name + ": node continuity");
+        expect(graph.isKNodeContinuous(family.nodeContinuity), family.name + ": k node continuity");
+        expect(!graph.isKNodeContinuous(family.nodeContinuity + 1), family.name + ": k + 1 node continuity");
+        expect(graph.getGirth() == family.girth, family.name + ": girth");
+        expect(graph.getCircumference() == family.circumference, family.name + ": circumference");
+        expect(graph.getChromaticNumber() == family.chromaticNumber, family.name + ": chromatic number");
+        expect(isColoring(family.matrix, graph.getColoring(), family.chromaticNumber), family.name + ": coloring");
+
+        if (graph.getDegree() <= FAMILY_TABLE_DEGREE)
+        {
+            const HamiltonDP dp(graph);
+
+            expect((dp.hasHamiltonRoute() == SearchResult::FOUND) == family.route, family.name + ": Held-Karp route");
+            expect((dp.hasHamiltonCircle() == SearchResult::FOUND) == family.circle, family.name + ": Held-Karp circle");
+        }
+    }
+
+    std::cout << checks << " checks, " << failures << " failed" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}